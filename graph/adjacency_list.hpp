@@ -4,7 +4,10 @@
 #include "graph.hpp"
 #include "detail/adjacency.hpp"
 #include "algorithm.hpp"
-#include <list>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
@@ -16,8 +19,41 @@ template <typename EdgeInfo> class AdjacencyListAdjacencyIterator;
 template <typename VertexInfo, typename EdgeInfo = bool>
 struct AdjacencyListVertex {
     explicit AdjacencyListVertex(const VertexInfo &vertex) : vertex(vertex) { }
+
+    explicit AdjacencyListVertex(VertexInfo &&vertex) : vertex(std::move(vertex)) { }
+
+    // construct the vertex info in place from args
+    template <typename... Args>
+    explicit AdjacencyListVertex(std::in_place_t, Args&&... args) : vertex(std::forward<Args>(args)...) { }
+
+    // position of the first neighbor id not less than to
+    std::size_t find(std::size_t to) const {
+        return std::lower_bound(targets.begin(), targets.end(), to) - targets.begin();
+    }
+
+    // restore the order of targets after the ids were renumbered
+    void sortEdges() {
+        std::vector<std::size_t> order(targets.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return targets[a] < targets[b]; });
+        std::vector<std::size_t> sorted_targets;
+        std::vector<detail::Boxed<EdgeInfo>> sorted_edge_infos;
+        sorted_targets.reserve(order.size());
+        sorted_edge_infos.reserve(order.size());
+        for (auto i : order) {
+            sorted_targets.push_back(targets[i]);
+            sorted_edge_infos.push_back(std::move(edge_infos[i]));
+        }
+        targets.swap(sorted_targets);
+        edge_infos.swap(sorted_edge_infos);
+    }
+
     VertexInfo vertex;
-    std::list<detail::AdjacencyVertex<EdgeInfo>> edges;
+    // neighbor ids and edge payloads are kept apart, so that scans over the
+    // topology do not pull the payloads into cache, targets are kept sorted
+    std::vector<std::size_t> targets;
+    std::vector<detail::Boxed<EdgeInfo>> edge_infos;
 };
 
 // An Aggregate class to define a graph represented by a adjacency list
@@ -30,10 +66,36 @@ public:
     using edge_info_reference = EdgeInfo &;
     using edge_info_const_reference = const EdgeInfo &;
     using iterator = AdjacencyListAdjacencyIterator<EdgeInfo>;
+    using const_iterator = iterator;
+    using neighbor_range = detail::NeighborSpan<EdgeInfo, iterator>;
 
     explicit AdjacencyList(const EdgeInfo &default_edge_info = detail::default_edge_info<EdgeInfo>)
         : default_edge_info(default_edge_info), vertices() { }
 
+    // capacity hints: room for vertex_number vertices, and for each of the first
+    // vertex_number vertices room for its share of edge_number edges
+    // vertices past those get no room in advance, reserve(0, 0) drops the hint
+    void reserve(size_type vertex_number, size_type edge_number = 0) {
+        vertices.reserve(vertex_number);
+        size_type arcs = IsDirected ? edge_number : 2 * edge_number;
+        degree_hint = vertex_number == 0 ? 0 : (arcs + vertex_number - 1) / vertex_number;
+        hinted_vertices = degree_hint == 0 ? 0 : vertex_number;
+        for (size_type i = 0; i < vertices.size(); ++i)
+            reserveEdges(i);
+    }
+
+    void swap(AdjacencyList &other) noexcept(std::is_nothrow_swappable_v<EdgeInfo>) {
+        using std::swap;
+        swap(default_edge_info, other.default_edge_info);
+        swap(vertices, other.vertices);
+        swap(degree_hint, other.degree_hint);
+        swap(hinted_vertices, other.hinted_vertices);
+    }
+
+    friend void swap(AdjacencyList &a, AdjacencyList &b) noexcept(noexcept(a.swap(b))) {
+        a.swap(b);
+    }
+
     const EdgeInfo& defaultEdgeInfo() const {
         return default_edge_info;
     }
@@ -42,7 +104,9 @@ public:
         return vertices.size();
     }
 
-    std::make_signed_t<size_type> indexOfVertex(const VertexInfo& v) const {
+    // v may be of any type comparable with VertexInfo, e.g. std::string_view for std::string
+    template <typename Key>
+    std::make_signed_t<size_type> indexOfVertex(const Key& v) const {
         for (size_type i = 0; i < vertices.size(); ++i) {
             if (vertices[i].vertex == v)
                 return i;
@@ -56,127 +120,320 @@ public:
         if (index != -1)
             return static_cast<size_type>(index);
         vertices.emplace_back(v);
+        reserveEdges(vertices.size() - 1);
         return vertices.size() - 1;
     }
 
+    size_type addVertex(VertexInfo&& v) {
+        auto index = indexOfVertex(v);
+        if (index != -1)
+            return static_cast<size_type>(index);
+        vertices.emplace_back(std::move(v));
+        reserveEdges(vertices.size() - 1);
+        return vertices.size() - 1;
+    }
+
+    // construct the vertex info in place, it is dropped again if the vertex already exists
+    // without spare capacity it is built aside and looked up first, so that a duplicate
+    // does not reallocate the vertices for nothing
+    template <typename... Args>
+    size_type emplaceVertex(Args&&... args) {
+        if (vertices.size() == vertices.capacity())
+            return addVertex(VertexInfo(std::forward<Args>(args)...));
+        auto &vertex = vertices.emplace_back(std::in_place, std::forward<Args>(args)...);
+        auto index = static_cast<size_type>(indexOfVertex(vertex.vertex));
+        if (index != vertices.size() - 1)
+            vertices.pop_back();
+        else
+            reserveEdges(index);
+        return index;
+    }
+
     const VertexInfo& getVertex(size_type index) const {
         return vertices[index].vertex;
     }
 
-    iterator adjacencyVertexBegin(const VertexInfo& from) {
-        auto index_from = indexOfVertex(from);
-        if (index_from == -1)
-            throw std::out_of_range("Vertex does not exist");
-        return iterator(vertices[from].edges.begin());
+    iterator adjacencyVertexBegin(const VertexInfo& from) const {
+        return adjacencyVertexBegin(checkedIndexOfVertex(from));
     }
 
-    iterator adjacencyVertexEnd(const VertexInfo& from) {
-        auto index_from = indexOfVertex(from);
-        if (index_from == -1)
-            throw std::out_of_range("Vertex does not exist");
-        return iterator(vertices[from].edges.end());
+    iterator adjacencyVertexEnd(const VertexInfo& from) const {
+        return adjacencyVertexEnd(checkedIndexOfVertex(from));
     }
 
-    iterator adjacencyVertexBegin(size_type from) {
-        if (from >= vertexNumber())
-            throw std::out_of_range("Vertex does not exist");
-        return iterator(vertices[from].edges.begin());
+    // the lookups by vertex also take any key comparable with VertexInfo, see indexOfVertex
+    template <typename Key, std::enable_if_t<detail::is_vertex_key_v<Key, VertexInfo>, int> = 0>
+    iterator adjacencyVertexBegin(const Key& from) const {
+        return adjacencyVertexBegin(checkedIndexOfVertex(from));
+    }
+
+    template <typename Key, std::enable_if_t<detail::is_vertex_key_v<Key, VertexInfo>, int> = 0>
+    iterator adjacencyVertexEnd(const Key& from) const {
+        return adjacencyVertexEnd(checkedIndexOfVertex(from));
+    }
+
+    iterator adjacencyVertexBegin(size_type from) const {
+        return neighbors(from).begin();
+    }
+
+    iterator adjacencyVertexEnd(size_type from) const {
+        return neighbors(from).end();
     }
 
-    iterator adjacencyVertexEnd(size_type from) {
+    // random access read only view of the {to, edge_info} records of a vertex
+    neighbor_range neighbors(size_type from) const {
         if (from >= vertexNumber())
             throw std::out_of_range("Vertex does not exist");
-        return iterator(vertices[from].edges.end());
+        const auto &vertex = vertices[from];
+        return neighbor_range(vertex.targets.data(), vertex.edge_infos.data(), vertex.targets.size());
+    }
+
+    neighbor_range neighbors(const VertexInfo& from) const {
+        return neighbors(checkedIndexOfVertex(from));
+    }
+
+    template <typename Key, std::enable_if_t<detail::is_vertex_key_v<Key, VertexInfo>, int> = 0>
+    neighbor_range neighbors(const Key& from) const {
+        return neighbors(checkedIndexOfVertex(from));
     }
 
     // access and insert
-    void setEdge(const VertexInfo& from, const VertexInfo& to, const EdgeInfo& e) {
+    void setEdge(const VertexInfo& from, const VertexInfo& to, EdgeInfo e) {
         auto index_from = addVertex(from);
         auto index_to = addVertex(to);
-        setEdge(index_from, index_to, e);
+        setEdge(index_from, index_to, std::move(e));
     }
 
-    void setEdge(std::size_t from, std::size_t to, const EdgeInfo& e) {
+    void setEdge(VertexInfo&& from, VertexInfo&& to, EdgeInfo e) {
+        auto index_from = addVertex(std::move(from));
+        auto index_to = addVertex(std::move(to));
+        setEdge(index_from, index_to, std::move(e));
+    }
+
+    // a vertex info is built from a key only when that vertex is new
+    template <typename From, typename To, std::enable_if_t<detail::is_vertex_key_pair_v<From, To, VertexInfo>, int> = 0>
+    void setEdge(From&& from, To&& to, EdgeInfo e) {
+        auto index_from = addVertexByKey(std::forward<From>(from));
+        auto index_to = addVertexByKey(std::forward<To>(to));
+        setEdge(index_from, index_to, std::move(e));
+    }
+
+    void setEdge(std::size_t from, std::size_t to, EdgeInfo e) {
         if (from >= vertexNumber() || to >= vertexNumber())
             throw std::out_of_range("Vertex does not exist");
-        auto &list = vertices[from].edges;
-        auto iter = list.begin(), end = list.end();
-        for (; iter != end; ++iter) {
-            if (iter->to == to) {
-                iter->edge_info = e;
-                return;
-            }
-        }
-        list.emplace_back(to, e);
         if constexpr (!IsDirected)
-            setEdge(to, from, e);
+            setArc(to, from, e);
+        setArc(from, to, std::move(e));
     }
 
     edge_info_const_reference getEdge(const VertexInfo& from, const VertexInfo& to) const {
         auto index_from = indexOfVertex(from);
         auto index_to = indexOfVertex(to);
-        if (index_from != -1 || index_to != -1) throw std::out_of_range("Vertex does not exist");
+        if (index_from == -1 || index_to == -1) throw std::out_of_range("Vertex does not exist");
         return getEdge(static_cast<std::size_t>(index_from), static_cast<std::size_t>(index_to));
     }
 
+    template <typename From, typename To, std::enable_if_t<detail::is_vertex_key_pair_v<From, To, VertexInfo>, int> = 0>
+    edge_info_const_reference getEdge(const From& from, const To& to) const {
+        return getEdge(checkedIndexOfVertex(from), checkedIndexOfVertex(to));
+    }
+
     edge_info_const_reference getEdge(std::size_t from, std::size_t to) const {
         if (from >= vertexNumber() || to >= vertexNumber())
             throw std::out_of_range("Vertex does not exist");
-        auto &list = vertices[from].edges;
-        auto iter = list.begin(), end = list.end();
-        for (; iter != end; ++iter) {
-            if (iter->to == to) {
-                return iter->edge_info;
-            }
+        const auto &vertex = vertices[from];
+        auto position = vertex.find(to);
+        if (position == vertex.targets.size() || vertex.targets[position] != to)
+            return default_edge_info;
+        return vertex.edge_infos[position].value;
+    }
+
+    // move vertex i to position old_to_new[i], edges are renumbered accordingly
+    void permuteVertices(const std::vector<size_type> &old_to_new) {
+        auto new_to_old = detail::check_permutation(old_to_new, vertexNumber());
+        std::vector<AdjacencyListVertex<VertexInfo, EdgeInfo>> permuted;
+        permuted.reserve(vertices.size());
+        for (auto i : new_to_old) {
+            for (auto &to : vertices[i].targets)
+                to = old_to_new[to];
+            vertices[i].sortEdges();
+            permuted.push_back(std::move(vertices[i]));
         }
-        return default_edge_info;
+        vertices.swap(permuted);
     }
 
 private:
+    friend struct detail::VertexAppender;
+
+    // add a vertex the caller knows is not in the graph yet, skipping the lookup of addVertex
+    // a duplicate would break indexOfVertex, so only the graph and partition use it
+    size_type appendVertex(const VertexInfo& v) {
+        vertices.emplace_back(v);
+        reserveEdges(vertices.size() - 1);
+        return vertices.size() - 1;
+    }
+
+    size_type appendVertex(VertexInfo&& v) {
+        vertices.emplace_back(std::move(v));
+        reserveEdges(vertices.size() - 1);
+        return vertices.size() - 1;
+    }
+
+    template <typename Key>
+    size_type checkedIndexOfVertex(const Key& v) const {
+        auto index = indexOfVertex(v);
+        if (index == -1)
+            throw std::out_of_range("Vertex does not exist");
+        return static_cast<size_type>(index);
+    }
+
+    template <typename Key>
+    size_type addVertexByKey(Key&& v) {
+        auto index = indexOfVertex(v);
+        if (index != -1)
+            return static_cast<size_type>(index);
+        return appendVertex(VertexInfo(std::forward<Key>(v)));
+    }
+
+    void reserveEdges(size_type index) {
+        if (index >= hinted_vertices)
+            return;
+        vertices[index].targets.reserve(degree_hint);
+        vertices[index].edge_infos.reserve(degree_hint);
+    }
+
+    // set the edge info of from->to only
+    template <typename E>
+    void setArc(std::size_t from, std::size_t to, E&& e) {
+        auto &vertex = vertices[from];
+        auto position = vertex.find(to);
+        bool exists = position != vertex.targets.size() && vertex.targets[position] == to;
+        if (e == default_edge_info) { // setting the default removes the edge
+            if (exists) {
+                vertex.targets.erase(vertex.targets.begin() + position);
+                vertex.edge_infos.erase(vertex.edge_infos.begin() + position);
+            }
+            return;
+        }
+        if (exists) {
+            vertex.edge_infos[position].value = std::forward<E>(e);
+            return;
+        }
+        vertex.targets.insert(vertex.targets.begin() + position, to);
+        vertex.edge_infos.insert(vertex.edge_infos.begin() + position, { std::forward<E>(e) });
+    }
+
+    EdgeInfo default_edge_info;
     std::vector<AdjacencyListVertex<VertexInfo, EdgeInfo>> vertices;
-    const EdgeInfo default_edge_info;
+    size_type degree_hint = 0; // edges to reserve for each of the first hinted_vertices vertices
+    size_type hinted_vertices = 0;
 };
 
 template<bool IsDirected, typename EdgeInfo>
 class AdjacencyList<IsDirected, std::size_t, EdgeInfo> {
 };
 
+// A proxy iterator over the adjacency records of a vertex
+// dereferencing yields a AdjacencyVertexRef by value, the payload is read lazily through it
+// a forward or random access iterator must yield a real reference, so it is tagged as an
+// input iterator; it still has the arithmetic, and NeighborSpan gives indexed access
 template <typename EdgeInfo>
 class AdjacencyListAdjacencyIterator {
 public:
-    explicit AdjacencyListAdjacencyIterator(
-            typename std::list<detail::AdjacencyVertex<EdgeInfo>>::iterator iterator
-    ) : iterator(iterator) { }
+    using iterator_category = std::input_iterator_tag;
+    using value_type = detail::AdjacencyVertex<EdgeInfo>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = detail::AdjacencyVertexRef<EdgeInfo>;
 
-    AdjacencyListAdjacencyIterator(const AdjacencyListAdjacencyIterator &other) {
-        iterator = other.iterator;
-    }
+    AdjacencyListAdjacencyIterator() : to(nullptr), info(nullptr) { }
+
+    AdjacencyListAdjacencyIterator(const std::size_t *to, const detail::Boxed<EdgeInfo> *info)
+        : to(to), info(info) { }
 
     AdjacencyListAdjacencyIterator& operator++ () {
-        ++iterator;
+        ++to; ++info;
         return *this;
     }
 
     AdjacencyListAdjacencyIterator operator++ (int) {
         AdjacencyListAdjacencyIterator res = *this;
-        ++ iterator;
+        ++*this;
         return res;
     }
 
-    const detail::AdjacencyVertex<EdgeInfo>& operator* () {
-        return *iterator;
+    AdjacencyListAdjacencyIterator& operator-- () {
+        --to; --info;
+        return *this;
+    }
+
+    AdjacencyListAdjacencyIterator operator-- (int) {
+        AdjacencyListAdjacencyIterator res = *this;
+        --*this;
+        return res;
+    }
+
+    AdjacencyListAdjacencyIterator& operator+= (difference_type n) {
+        to += n; info += n;
+        return *this;
+    }
+
+    AdjacencyListAdjacencyIterator& operator-= (difference_type n) {
+        to -= n; info -= n;
+        return *this;
+    }
+
+    AdjacencyListAdjacencyIterator operator+ (difference_type n) const {
+        return AdjacencyListAdjacencyIterator(to + n, info + n);
+    }
+
+    friend AdjacencyListAdjacencyIterator operator+ (difference_type n, const AdjacencyListAdjacencyIterator &i) {
+        return i + n;
+    }
+
+    AdjacencyListAdjacencyIterator operator- (difference_type n) const {
+        return AdjacencyListAdjacencyIterator(to - n, info - n);
+    }
+
+    difference_type operator- (const AdjacencyListAdjacencyIterator &other) const {
+        return to - other.to;
+    }
+
+    reference operator* () const {
+        return { *to, info->value };
+    }
+
+    reference operator[] (difference_type n) const {
+        return { to[n], info[n].value };
+    }
+
+    bool operator== (const AdjacencyListAdjacencyIterator &other) const {
+        return to == other.to;
+    }
+
+    bool operator!= (const AdjacencyListAdjacencyIterator &other) const {
+        return to != other.to;
+    }
+
+    bool operator< (const AdjacencyListAdjacencyIterator &other) const {
+        return to < other.to;
+    }
+
+    bool operator> (const AdjacencyListAdjacencyIterator &other) const {
+        return to > other.to;
     }
 
-    bool operator== (const AdjacencyListAdjacencyIterator &other) {
-        return iterator == other.iterator;
+    bool operator<= (const AdjacencyListAdjacencyIterator &other) const {
+        return to <= other.to;
     }
 
-    bool operator!= (const AdjacencyListAdjacencyIterator &other) {
-        return iterator != other.iterator;
+    bool operator>= (const AdjacencyListAdjacencyIterator &other) const {
+        return to >= other.to;
     }
 
 protected:
-    typename std::list<detail::AdjacencyVertex<EdgeInfo>>::iterator iterator;
+    const std::size_t *to;
+    const detail::Boxed<EdgeInfo> *info;
 };
 
 } // namespace graph
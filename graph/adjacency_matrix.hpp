@@ -6,6 +6,9 @@
 #include "algorithm.hpp"
 #include "detail/adjacency.hpp"
 #include <type_traits>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include <stdexcept>
 
 namespace graph {
@@ -22,10 +25,29 @@ public:
     using edge_info_reference = typename Matrix<EdgeInfo>::reference;
     using edge_info_const_reference = typename Matrix<EdgeInfo>::const_reference;
     using iterator = AdjacencyMatrixAdjacencyIterator<EdgeInfo>;
+    using const_iterator = iterator;
+    using neighbor_range = detail::IteratorRange<iterator>;
 
     explicit AdjacencyMatrix(const EdgeInfo &default_edge_info = detail::default_edge_info<EdgeInfo>)
         : default_edge_info(default_edge_info), vertices(), matrix() { }
 
+    // capacity hint, the matrix grows without reallocating up to vertex_number vertices
+    void reserve(size_type vertex_number, size_type /* edge_number */ = 0) {
+        vertices.reserve(vertex_number);
+        matrix.reserve(vertex_number, vertex_number);
+    }
+
+    void swap(AdjacencyMatrix &other) noexcept(std::is_nothrow_swappable_v<EdgeInfo>) {
+        using std::swap;
+        swap(default_edge_info, other.default_edge_info);
+        swap(vertices, other.vertices);
+        swap(matrix, other.matrix);
+    }
+
+    friend void swap(AdjacencyMatrix &a, AdjacencyMatrix &b) noexcept(noexcept(a.swap(b))) {
+        a.swap(b);
+    }
+
     const EdgeInfo& defaultEdgeInfo() const {
         return default_edge_info;
     }
@@ -34,7 +56,9 @@ public:
         return vertices.size();
     }
 
-    std::make_signed_t<size_type> indexOfVertex(const VertexInfo& v) const {
+    // v may be of any type comparable with VertexInfo, e.g. std::string_view for std::string
+    template <typename Key>
+    std::make_signed_t<size_type> indexOfVertex(const Key& v) const {
         for (size_type i = 0; i < vertices.size(); ++i) {
             if (vertices[i] == v)
                 return i;
@@ -52,56 +76,118 @@ public:
         return vertices.size() - 1;
     }
 
+    size_type addVertex(VertexInfo&& v) {
+        auto index = indexOfVertex(v);
+        if (index != -1)
+            return static_cast<size_type>(index);
+        vertices.push_back(std::move(v));
+        matrix.resize(vertices.size(), vertices.size(), default_edge_info);
+        return vertices.size() - 1;
+    }
+
+    // construct the vertex info in place, it is dropped again if the vertex already exists
+    // without spare capacity it is built aside and looked up first, so that a duplicate
+    // does not reallocate the vertices for nothing
+    template <typename... Args>
+    size_type emplaceVertex(Args&&... args) {
+        if (vertices.size() == vertices.capacity())
+            return addVertex(VertexInfo(std::forward<Args>(args)...));
+        auto index = static_cast<size_type>(indexOfVertex(vertices.emplace_back(std::forward<Args>(args)...)));
+        if (index != vertices.size() - 1)
+            vertices.pop_back();
+        else
+            matrix.resize(vertices.size(), vertices.size(), default_edge_info);
+        return index;
+    }
+
     const VertexInfo& getVertex(size_type index) const {
         return vertices[index];
     }
 
-    iterator adjacencyVertexBegin(const VertexInfo& from) {
-        auto index_from = indexOfVertex(from);
-        if (index_from == -1)
-            throw std::out_of_range("Vertex does not exist");
-        return iterator(matrix, index_from, default_edge_info, 0);
+    iterator adjacencyVertexBegin(const VertexInfo& from) const {
+        return adjacencyVertexBegin(checkedIndexOfVertex(from));
     }
 
-    iterator adjacencyVertexEnd(const VertexInfo& from) {
-        auto index_from = indexOfVertex(from);
-        if (index_from == -1)
-            throw std::out_of_range("Vertex does not exist");
-        return iterator(matrix, index_from, default_edge_info, matrix.columns());
+    iterator adjacencyVertexEnd(const VertexInfo& from) const {
+        return adjacencyVertexEnd(checkedIndexOfVertex(from));
+    }
+
+    // the lookups by vertex also take any key comparable with VertexInfo, see indexOfVertex
+    template <typename Key, std::enable_if_t<detail::is_vertex_key_v<Key, VertexInfo>, int> = 0>
+    iterator adjacencyVertexBegin(const Key& from) const {
+        return adjacencyVertexBegin(checkedIndexOfVertex(from));
+    }
+
+    template <typename Key, std::enable_if_t<detail::is_vertex_key_v<Key, VertexInfo>, int> = 0>
+    iterator adjacencyVertexEnd(const Key& from) const {
+        return adjacencyVertexEnd(checkedIndexOfVertex(from));
     }
 
-    iterator adjacencyVertexBegin(size_type from) {
+    iterator adjacencyVertexBegin(size_type from) const {
         if (from >= vertexNumber())
             throw std::out_of_range("Vertex does not exist");
         return iterator(matrix, from, default_edge_info, 0);
     }
 
-    iterator adjacencyVertexEnd(size_type from) {
+    iterator adjacencyVertexEnd(size_type from) const {
         if (from >= vertexNumber())
             throw std::out_of_range("Vertex does not exist");
         return iterator(matrix, from, default_edge_info, matrix.columns());
     }
 
+    // read only range of the {to, edge_info} records of a vertex, skipping default edges
+    neighbor_range neighbors(size_type from) const {
+        return neighbor_range(adjacencyVertexBegin(from), adjacencyVertexEnd(from));
+    }
+
+    neighbor_range neighbors(const VertexInfo& from) const {
+        return neighbors(checkedIndexOfVertex(from));
+    }
+
+    template <typename Key, std::enable_if_t<detail::is_vertex_key_v<Key, VertexInfo>, int> = 0>
+    neighbor_range neighbors(const Key& from) const {
+        return neighbors(checkedIndexOfVertex(from));
+    }
+
     // access and insert
-    void setEdge(const VertexInfo& from, const VertexInfo& to, const EdgeInfo& e) {
+    void setEdge(const VertexInfo& from, const VertexInfo& to, EdgeInfo e) {
         auto index_from = addVertex(from);
         auto index_to = addVertex(to);
-        setEdge(index_from, index_to, e);
+        setEdge(index_from, index_to, std::move(e));
+    }
+
+    void setEdge(VertexInfo&& from, VertexInfo&& to, EdgeInfo e) {
+        auto index_from = addVertex(std::move(from));
+        auto index_to = addVertex(std::move(to));
+        setEdge(index_from, index_to, std::move(e));
+    }
+
+    // a vertex info is built from a key only when that vertex is new
+    template <typename From, typename To, std::enable_if_t<detail::is_vertex_key_pair_v<From, To, VertexInfo>, int> = 0>
+    void setEdge(From&& from, To&& to, EdgeInfo e) {
+        auto index_from = addVertexByKey(std::forward<From>(from));
+        auto index_to = addVertexByKey(std::forward<To>(to));
+        setEdge(index_from, index_to, std::move(e));
     }
 
-    void setEdge(std::size_t from, std::size_t to, const EdgeInfo& e) {
+    void setEdge(std::size_t from, std::size_t to, EdgeInfo e) {
         if (from >= vertexNumber() || to >= vertexNumber())
             throw std::out_of_range("Vertex does not exist");
-        matrix(from, to) = e;
         if constexpr (!IsDirected)
             matrix(to, from) = e;
+        matrix(from, to) = std::move(e);
     }
 
     edge_info_const_reference getEdge(const VertexInfo& from, const VertexInfo& to) const {
         auto index_from = indexOfVertex(from);
         auto index_to = indexOfVertex(to);
         if (index_from == -1 || index_to == -1) throw std::out_of_range("Vertex does not exist");
-        return getEdge(index_from, index_to);
+        return getEdge(static_cast<size_type>(index_from), static_cast<size_type>(index_to));
+    }
+
+    template <typename From, typename To, std::enable_if_t<detail::is_vertex_key_pair_v<From, To, VertexInfo>, int> = 0>
+    edge_info_const_reference getEdge(const From& from, const To& to) const {
+        return getEdge(checkedIndexOfVertex(from), checkedIndexOfVertex(to));
     }
 
     edge_info_const_reference getEdge(std::size_t from, std::size_t to) const {
@@ -110,39 +196,89 @@ public:
         return matrix(from, to);
     }
 
+    // move vertex i to position old_to_new[i], edges are renumbered accordingly
+    void permuteVertices(const std::vector<size_type> &old_to_new) {
+        auto new_to_old = detail::check_permutation(old_to_new, vertexNumber());
+        std::vector<VertexInfo> permuted_vertices;
+        permuted_vertices.reserve(vertices.size());
+        Matrix<EdgeInfo> permuted_matrix;
+        permuted_matrix.resize(vertices.size(), vertices.size(), default_edge_info);
+        for (size_type i = 0; i < vertices.size(); ++i) {
+            permuted_vertices.push_back(std::move(vertices[new_to_old[i]]));
+            for (size_type j = 0; j < vertices.size(); ++j)
+                permuted_matrix(i, j) = matrix.at(new_to_old[i], new_to_old[j]);
+        }
+        vertices.swap(permuted_vertices);
+        matrix = std::move(permuted_matrix);
+    }
+
 private:
+    friend struct detail::VertexAppender;
+
+    // add a vertex the caller knows is not in the graph yet, skipping the lookup of addVertex
+    // a duplicate would break indexOfVertex, so only the graph and partition use it
+    size_type appendVertex(const VertexInfo& v) {
+        vertices.push_back(v);
+        matrix.resize(vertices.size(), vertices.size(), default_edge_info);
+        return vertices.size() - 1;
+    }
+
+    size_type appendVertex(VertexInfo&& v) {
+        vertices.push_back(std::move(v));
+        matrix.resize(vertices.size(), vertices.size(), default_edge_info);
+        return vertices.size() - 1;
+    }
+
+    template <typename Key>
+    size_type checkedIndexOfVertex(const Key& v) const {
+        auto index = indexOfVertex(v);
+        if (index == -1)
+            throw std::out_of_range("Vertex does not exist");
+        return static_cast<size_type>(index);
+    }
+
+    template <typename Key>
+    size_type addVertexByKey(Key&& v) {
+        auto index = indexOfVertex(v);
+        if (index != -1)
+            return static_cast<size_type>(index);
+        return appendVertex(VertexInfo(std::forward<Key>(v)));
+    }
+
+    EdgeInfo default_edge_info;
     std::vector<VertexInfo> vertices;
     Matrix<EdgeInfo> matrix;
-    const EdgeInfo default_edge_info;
 };
 
 template<bool IsDirected, typename EdgeInfo>
 class AdjacencyMatrix<IsDirected, std::size_t, EdgeInfo> {
 };
 
+// An iterator over the non default entries of a matrix row
+// dereferencing yields the {to, edge_info} record by value, so it is tagged as an input iterator
 template <typename EdgeInfo>
 class AdjacencyMatrixAdjacencyIterator {
 public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = detail::AdjacencyVertex<EdgeInfo>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
     explicit AdjacencyMatrixAdjacencyIterator(
-            Matrix<EdgeInfo>& matrix,
+            const Matrix<EdgeInfo>& matrix,
             std::size_t row,
             const EdgeInfo& default_edge_info,
             std::size_t init = 0)
-        : matrix(matrix), default_edge_info(default_edge_info) {
+        : matrix(&matrix), row(row), default_edge_info(&default_edge_info), index(init) {
         if (row >= matrix.rows())
             throw std::out_of_range("Matrix row out of range");
         if (init > matrix.columns())
             throw std::out_of_range("Initial index out of range");
-        this->row = row;
-        this->index = init;
         if (index != matrix.columns() && matrix.at(row, index) == default_edge_info)
             increase();
     }
 
-    AdjacencyMatrixAdjacencyIterator(const AdjacencyMatrixAdjacencyIterator &other)
-        : matrix(other.matrix), row(row),
-          default_edge_info(other.default_edge_info), index(other.index) { }
-
     AdjacencyMatrixAdjacencyIterator& operator++ () {
         increase();
         return *this;
@@ -154,35 +290,35 @@ public:
         return res;
     }
 
-    detail::AdjacencyVertex<EdgeInfo> operator* () {
-        return { index, matrix.at(row, index) };
+    reference operator* () const {
+        return { index, matrix->at(row, index) };
     }
 
-    bool operator== (const AdjacencyMatrixAdjacencyIterator &other) {
-        return &matrix == &other.matrix &&
+    bool operator== (const AdjacencyMatrixAdjacencyIterator &other) const {
+        return matrix == other.matrix &&
                 row == other.row &&
                 default_edge_info == other.default_edge_info &&
                 index == other.index;
     }
 
-    bool operator!= (const AdjacencyMatrixAdjacencyIterator &other) {
+    bool operator!= (const AdjacencyMatrixAdjacencyIterator &other) const {
         return !(*this == other);
     }
 
 private:
     void increase() {
-        if (index >= matrix.columns() - 1) {
-            index = matrix.columns();
+        if (index >= matrix->columns() - 1) {
+            index = matrix->columns();
             return;
         }
         do {
             ++index;
-        } while (index != matrix.columns() && matrix.at(row, index) == default_edge_info);
+        } while (index != matrix->columns() && matrix->at(row, index) == *default_edge_info);
     }
 
-    Matrix<EdgeInfo>& matrix;
+    const Matrix<EdgeInfo>* matrix;
     std::size_t row;
-    const EdgeInfo& default_edge_info; // reference to default edge info of AdjacencyMatrix
+    const EdgeInfo* default_edge_info; // points to default edge info of AdjacencyMatrix
 
     std::size_t index;
 };
@@ -6,7 +6,10 @@
 #include <iostream>
 #include <iomanip>
 #include <tuple>
+#include <utility>
 #include <initializer_list>
+#include <vector>
+#include <stdexcept>
 
 #include "graph.hpp"
 #include "detail/algorithm.hpp"
@@ -21,8 +24,8 @@ typename G::size_type get_vertex_number(G &g) {
     return g.vertexNumber();
 };
 
-template <typename G>
-std::make_signed_t<typename G::size_type> get_vertex_index(G &g, const typename G::vertex_info_type& vertex) {
+template <typename G, typename Key>
+std::make_signed_t<typename G::size_type> get_vertex_index(G &g, const Key& vertex) {
     return g.indexOfVertex(vertex);
 }
 
@@ -31,33 +34,30 @@ const typename G::vertex_info_type &get_vertex(G &g, typename G::size_type index
     return g.getVertex(index);
 }
 
-template <typename G>
-void add_vertex(G &g, const typename G::vertex_info_type& v) {
-    g.addVertex(v);
+template <typename G, typename V>
+void add_vertex(G &g, V&& v) {
+    g.addVertex(std::forward<V>(v));
 };
 
-template <typename G, typename... Args>
-void add_vertex(G &g, const typename G::vertex_info_type& v, const Args&... args) {
-    add_vertex(g, v);
-    add_vertex(g, args...);
+template <typename G, typename V, typename... Args>
+void add_vertex(G &g, V&& v, Args&&... args) {
+    add_vertex(g, std::forward<V>(v));
+    add_vertex(g, std::forward<Args>(args)...);
 };
 
-template <typename G, typename V1, typename V2>
-void set_edge(G &g,
-        const V1& v1,
-        const V2& v2,
-        const typename G::edge_info_type& e) {
-    g.setEdge(v1, v2, e);
+template <typename G, typename V1, typename V2, typename E = typename G::edge_info_type>
+void set_edge(G &g, V1&& v1, V2&& v2, E&& e) {
+    g.setEdge(std::forward<V1>(v1), std::forward<V2>(v2), std::forward<E>(e));
 };
 
 template <typename G, typename V1, typename V2>
-void add_edge(G &g, const V1& v1, const V2& v2) {
-    set_edge(g, v1, v2, static_cast<typename G::edge_info_type>(true));
+void add_edge(G &g, V1&& v1, V2&& v2) {
+    set_edge(g, std::forward<V1>(v1), std::forward<V2>(v2), static_cast<typename G::edge_info_type>(true));
 };
 
 template <typename G, typename V1, typename V2>
-void remove_edge(G &g, const V1& v1, const V2& v2) {
-    set_edge(g, v1, v2, g.defaultEdgeInfo());
+void remove_edge(G &g, V1&& v1, V2&& v2) {
+    set_edge(g, std::forward<V1>(v1), std::forward<V2>(v2), g.defaultEdgeInfo());
 };
 
 template <typename G, typename V1, typename V2>
@@ -89,13 +89,87 @@ void breadth_first_traverse(G &g, Visit&& visit) {
     }
 }
 
+// Reusable state for single source traversals
+// a vertex is visited iff its stamp equals the current epoch, so starting a new
+// traversal only bumps the epoch instead of clearing the whole array
+class TraverseWorkspace {
+public:
+    using size_type = std::size_t;
+    using epoch_type = unsigned int;
+
+    // start a new traversal over a graph with n vertices
+    void reset(size_type n) {
+        if (stamps.size() < n)
+            stamps.resize(n, 0);
+        if (++epoch == 0) { // wrapped around, old stamps may collide
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+        current.clear();
+        next.clear();
+    }
+
+    bool visited(size_type v) const {
+        return stamps[v] == epoch;
+    }
+
+    void markVisited(size_type v) {
+        stamps[v] = epoch;
+    }
+
+    std::vector<std::pair<std::make_signed_t<size_type>, size_type>> current, next;
+
+private:
+    std::vector<epoch_type> stamps;
+    epoch_type epoch = 0;
+};
+
+// breadth first traverse the vertices reachable from source within max_depth hops
+// visit is called as visit(g, from, to, depth), from is -1 for the source
+template <typename G, typename Visit>
+void breadth_first_traverse_from(G &g, typename G::size_type source,
+        typename G::size_type max_depth, Visit&& visit, TraverseWorkspace &workspace) {
+    using size_type = typename G::size_type;
+    if (source >= get_vertex_number(g))
+        throw std::out_of_range("Vertex does not exist");
+    workspace.reset(get_vertex_number(g));
+    workspace.markVisited(source);
+    workspace.current.emplace_back(-1, source);
+    for (size_type depth = 0; !workspace.current.empty(); ++depth) {
+        for (auto pair : workspace.current) {
+            std::forward<Visit>(visit)(g, pair.first, pair.second, depth);
+            if (depth == max_depth)
+                continue;
+            for (auto beg = g.adjacencyVertexBegin(pair.second), end = g.adjacencyVertexEnd(pair.second);
+                 beg != end; ++beg) {
+                auto to = (*beg).to;
+                if (!workspace.visited(to)) {
+                    workspace.markVisited(to);
+                    workspace.next.emplace_back(pair.second, to);
+                }
+            }
+        }
+        workspace.current.swap(workspace.next);
+        workspace.next.clear();
+    }
+}
+
+template <typename G, typename Visit>
+void breadth_first_traverse_from(G &g, typename G::size_type source,
+        typename G::size_type max_depth, Visit&& visit) {
+    TraverseWorkspace workspace;
+    breadth_first_traverse_from(g, source, max_depth, std::forward<Visit>(visit), workspace);
+}
+
 namespace detail {
 
 template<typename G, typename Visit>
 void depth_first_traverse(G &g, Visit&& visit, long long from, long long i, std::vector<bool> &visited) {
     visited[i] = true;
     std::forward<Visit>(visit)(g, from, i);
-    for (auto beg = g.adjacencyVertexBegin(i), end = g.adjacencyVertexEnd(i);
+    // look up by index, i must not be taken for a vertex info
+    auto index = static_cast<typename G::size_type>(i);
+    for (auto beg = g.adjacencyVertexBegin(index), end = g.adjacencyVertexEnd(index);
          beg != end; ++beg) {
         if (!visited[(*beg).to])
             depth_first_traverse(g, visit, i, (*beg).to, visited);
@@ -0,0 +1,152 @@
+#ifndef GRAPH_BATCH_TRAVERSE_HPP_INCLUDED
+#define GRAPH_BATCH_TRAVERSE_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "thread_pool.hpp"
+#include "detail/bits.hpp"
+
+namespace graph {
+
+namespace detail {
+
+// State of a bit-parallel multi source breadth first search
+// bit i of a mask stands for the i-th source of the current batch
+struct MultiSourceWorkspace {
+    using mask_type = std::uint64_t;
+    static constexpr std::size_t width = 64;
+
+    void reserve(std::size_t n) {
+        if (seen.size() < n) {
+            seen.resize(n, 0);
+            visit.resize(n, 0);
+            next.resize(n, 0);
+        }
+    }
+
+    // masks are kept zero between batches, only touched entries are cleared
+    // vertices of next_frontier are not touched yet when a visit threw mid level
+    void clear() {
+        for (auto v : touched)
+            seen[v] = visit[v] = next[v] = 0;
+        for (auto v : next_frontier)
+            next[v] = 0;
+        touched.clear();
+        frontier.clear();
+        next_frontier.clear();
+    }
+
+    std::vector<mask_type> seen, visit, next;
+    std::vector<std::size_t> touched, frontier, next_frontier;
+};
+
+// the levels of a multi source search, leaves its marks in ws for the caller to clear
+template <typename G, typename Visit>
+void multi_source_breadth_first_levels(G &g, const typename G::size_type *sources, std::size_t count,
+        std::size_t first_query, typename G::size_type max_depth, Visit &visit, MultiSourceWorkspace &ws) {
+    using mask_type = MultiSourceWorkspace::mask_type;
+
+    auto report = [&](std::size_t v, mask_type mask, typename G::size_type depth) {
+        while (mask != 0) {
+            visit(g, first_query + count_trailing_zeros(mask), v, depth);
+            mask &= mask - 1;
+        }
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto s = sources[i];
+        if (ws.seen[s] == 0) {
+            ws.touched.push_back(s);
+            ws.frontier.push_back(s);
+        }
+        ws.seen[s] |= mask_type(1) << i;
+        ws.visit[s] |= mask_type(1) << i;
+    }
+    for (auto v : ws.frontier)
+        report(v, ws.visit[v], 0);
+
+    for (typename G::size_type depth = 1; !ws.frontier.empty() && depth <= max_depth; ++depth) {
+        for (auto v : ws.frontier) {
+            mask_type mask = ws.visit[v];
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+                auto u = (*beg).to;
+                mask_type d = mask & ~ws.seen[u];
+                if (d == 0)
+                    continue;
+                if (ws.next[u] == 0)
+                    ws.next_frontier.push_back(u);
+                ws.next[u] |= d;
+            }
+        }
+        for (auto v : ws.frontier)
+            ws.visit[v] = 0;
+        for (auto u : ws.next_frontier) {
+            if (ws.seen[u] == 0)
+                ws.touched.push_back(u);
+            ws.seen[u] |= ws.next[u];
+            ws.visit[u] = ws.next[u];
+            ws.next[u] = 0;
+            report(u, ws.visit[u], depth);
+        }
+        ws.frontier.swap(ws.next_frontier);
+        ws.next_frontier.clear();
+    }
+}
+
+// traverse from at most 64 sources at once, sharing every adjacency scan between them
+template <typename G, typename Visit>
+void multi_source_breadth_first_traverse(G &g, const typename G::size_type *sources, std::size_t count,
+        std::size_t first_query, typename G::size_type max_depth, Visit &visit, MultiSourceWorkspace &ws) {
+    ws.reserve(get_vertex_number(g));
+    try {
+        multi_source_breadth_first_levels(g, sources, count, first_query, max_depth, visit, ws);
+    } catch (...) {
+        ws.clear(); // the workspace is kept for the next batch on this thread
+        throw;
+    }
+    ws.clear();
+}
+
+} // ! namespace graph::detail
+
+// Run one depth limited breadth first traverse per source on the pool
+// sources are processed in batches of 64 by a bit-parallel multi source search
+// visit is called as visit(g, query, vertex, depth) where query indexes sources,
+// calls for different batches may run concurrently, g must not be modified meanwhile
+// if visit throws, the remaining batches still run and the first exception is rethrown
+template <typename G, typename Visit>
+void breadth_first_traverse_batch(G &g, const std::vector<typename G::size_type> &sources,
+        typename G::size_type max_depth, Visit &&visit, ThreadPool &pool) {
+    constexpr std::size_t width = detail::MultiSourceWorkspace::width;
+    for (auto s : sources) {
+        if (s >= get_vertex_number(g))
+            throw std::out_of_range("Vertex does not exist");
+    }
+    TaskGroup group(pool);
+    for (std::size_t first = 0; first < sources.size(); first += width) {
+        std::size_t count = std::min(width, sources.size() - first);
+        group.submit([&g, &sources, &visit, first, count, max_depth]() {
+            static thread_local detail::MultiSourceWorkspace workspace;
+            detail::multi_source_breadth_first_traverse(
+                    g, sources.data() + first, count, first, max_depth, visit, workspace);
+        });
+    }
+    group.wait();
+}
+
+template <typename G, typename Visit>
+void breadth_first_traverse_batch(G &g, const std::vector<typename G::size_type> &sources,
+        typename G::size_type max_depth, Visit &&visit, std::size_t threads = 0) {
+    ThreadPool pool(threads);
+    breadth_first_traverse_batch(g, sources, max_depth, std::forward<Visit>(visit), pool);
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_BATCH_TRAVERSE_HPP_INCLUDED
@@ -0,0 +1,259 @@
+#ifndef GRAPH_COMPRESSED_GRAPH_HPP_INCLUDED
+#define GRAPH_COMPRESSED_GRAPH_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "detail/adjacency.hpp"
+
+namespace graph {
+
+namespace detail {
+
+inline void write_varint(std::vector<std::uint8_t> &out, std::uint64_t x) {
+    while (x >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(x));
+}
+
+inline std::uint64_t read_varint(const std::uint8_t *&in) {
+    std::uint64_t x = *in++;
+    if (x < 0x80)
+        return x;
+    x &= 0x7f;
+    for (int shift = 7; ; shift += 7) {
+        std::uint64_t byte = *in++;
+        x |= (byte & 0x7f) << shift;
+        if (byte < 0x80)
+            return x;
+    }
+}
+
+} // ! namespace graph::detail
+
+// An iterator decoding one neighbor id per step
+// dereferencing yields the {to, true} record by value, so it is tagged as an input iterator
+class CompressedAdjacencyIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = detail::AdjacencyVertex<bool>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    // in points to the encoded ids after the degree
+    CompressedAdjacencyIterator(const std::uint8_t *in, std::size_t remaining)
+        : in(in), remaining(remaining), current(0) {
+        if (remaining != 0)
+            current = detail::read_varint(this->in);
+    }
+
+    CompressedAdjacencyIterator& operator++ () {
+        if (--remaining != 0)
+            current += detail::read_varint(in) + 1;
+        return *this;
+    }
+
+    CompressedAdjacencyIterator operator++ (int) {
+        CompressedAdjacencyIterator res = *this;
+        ++*this;
+        return res;
+    }
+
+    reference operator* () const {
+        return { current, true };
+    }
+
+    bool operator== (const CompressedAdjacencyIterator &other) const {
+        return remaining == other.remaining;
+    }
+
+    bool operator!= (const CompressedAdjacencyIterator &other) const {
+        return !(*this == other);
+    }
+
+private:
+    const std::uint8_t *in;
+    std::size_t remaining;
+    std::size_t current;
+};
+
+// An immutable topology only graph, the sorted neighbor ids of every vertex are
+// delta encoded as varints: degree, first id, then the gaps minus one
+// edge info is bool, every stored edge is true
+template <bool IsDirected, typename VertexInfo>
+class CompressedGraph : public GraphTag<IsDirected, VertexInfo, bool> {
+public:
+    using size_type = std::size_t;
+    using vertex_reference = const VertexInfo &;
+    using vertex_const_reference = const VertexInfo &;
+    using edge_info_reference = bool;
+    using edge_info_const_reference = bool;
+    using iterator = CompressedAdjacencyIterator;
+    using const_iterator = iterator;
+    using neighbor_range = detail::IteratorRange<iterator>;
+
+    CompressedGraph() : offsets(1, 0), bytes(padding, 0) { }
+
+    // compress the topology of g
+    template <typename G>
+    explicit CompressedGraph(const G &g) {
+        static_assert(G::is_directed == IsDirected, "Directedness of the graphs must match");
+        size_type n = get_vertex_number(g);
+        vertices.reserve(n);
+        offsets.reserve(n + 1);
+        std::vector<size_type> ids;
+        for (size_type i = 0; i < n; ++i) {
+            vertices.push_back(get_vertex(g, i));
+            ids.clear();
+            for (auto beg = g.adjacencyVertexBegin(i), end = g.adjacencyVertexEnd(i); beg != end; ++beg)
+                ids.push_back((*beg).to);
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            offsets.push_back(bytes.size());
+            detail::write_varint(bytes, ids.size());
+            for (size_type k = 0; k < ids.size(); ++k)
+                detail::write_varint(bytes, k == 0 ? ids[0] : ids[k] - ids[k - 1] - 1);
+            edges += ids.size();
+        }
+        offsets.push_back(bytes.size());
+        bytes.resize(bytes.size() + padding, 0); // lets the bulk decoder read whole words
+        bytes.shrink_to_fit();
+    }
+
+    bool defaultEdgeInfo() const {
+        return false;
+    }
+
+    size_type vertexNumber() const {
+        return vertices.size();
+    }
+
+    // number of stored directed adjacency entries
+    size_type edgeNumber() const {
+        return edges;
+    }
+
+    // bytes used by the encoded adjacency
+    size_type compressedBytes() const {
+        return offsets.back();
+    }
+
+    std::make_signed_t<size_type> indexOfVertex(const VertexInfo& v) const {
+        for (size_type i = 0; i < vertices.size(); ++i) {
+            if (vertices[i] == v)
+                return i;
+        }
+        return -1;
+    }
+
+    const VertexInfo& getVertex(size_type index) const {
+        return vertices[index];
+    }
+
+    size_type degree(size_type from) const {
+        const std::uint8_t *in = begin(from);
+        return detail::read_varint(in);
+    }
+
+    iterator adjacencyVertexBegin(size_type from) const {
+        const std::uint8_t *in = begin(from);
+        size_type count = detail::read_varint(in);
+        return iterator(in, count);
+    }
+
+    iterator adjacencyVertexEnd(size_type from) const {
+        begin(from); // range check
+        return iterator(nullptr, 0);
+    }
+
+    iterator adjacencyVertexBegin(const VertexInfo& from) const {
+        return adjacencyVertexBegin(checkedIndexOfVertex(from));
+    }
+
+    iterator adjacencyVertexEnd(const VertexInfo& from) const {
+        return adjacencyVertexEnd(checkedIndexOfVertex(from));
+    }
+
+    neighbor_range neighbors(size_type from) const {
+        return neighbor_range(adjacencyVertexBegin(from), adjacencyVertexEnd(from));
+    }
+
+    neighbor_range neighbors(const VertexInfo& from) const {
+        return neighbors(checkedIndexOfVertex(from));
+    }
+
+    // decode the whole adjacency of a vertex at once, runs of single byte gaps
+    // are detected a word at a time and decoded without per byte branches
+    void decodeNeighbors(size_type from, std::vector<size_type> &out) const {
+        const std::uint8_t *in = begin(from);
+        size_type count = detail::read_varint(in);
+        out.resize(count);
+        size_type k = 0, previous = 0;
+        if (count != 0)
+            previous = out[k++] = detail::read_varint(in);
+        while (k < count) {
+            std::uint64_t word;
+            std::memcpy(&word, in, sizeof(word));
+            if (count - k >= 8 && (word & 0x8080808080808080ull) == 0) {
+                for (int b = 0; b < 8; ++b)
+                    previous = out[k++] = previous + in[b] + 1;
+                in += 8;
+            } else {
+                previous = out[k++] = previous + detail::read_varint(in) + 1;
+            }
+        }
+    }
+
+    bool getEdge(size_type from, size_type to) const {
+        if (from >= vertexNumber() || to >= vertexNumber())
+            throw std::out_of_range("Vertex does not exist");
+        for (auto beg = adjacencyVertexBegin(from), end = adjacencyVertexEnd(from); beg != end; ++beg) {
+            auto id = (*beg).to;
+            if (id >= to)
+                return id == to;
+        }
+        return false;
+    }
+
+    bool getEdge(const VertexInfo& from, const VertexInfo& to) const {
+        auto index_from = indexOfVertex(from);
+        auto index_to = indexOfVertex(to);
+        if (index_from == -1 || index_to == -1) throw std::out_of_range("Vertex does not exist");
+        return getEdge(static_cast<size_type>(index_from), static_cast<size_type>(index_to));
+    }
+
+private:
+    static constexpr size_type padding = 8;
+
+    const std::uint8_t *begin(size_type from) const {
+        if (from >= vertexNumber())
+            throw std::out_of_range("Vertex does not exist");
+        return bytes.data() + offsets[from];
+    }
+
+    size_type checkedIndexOfVertex(const VertexInfo& v) const {
+        auto index = indexOfVertex(v);
+        if (index == -1)
+            throw std::out_of_range("Vertex does not exist");
+        return static_cast<size_type>(index);
+    }
+
+    std::vector<VertexInfo> vertices;
+    std::vector<size_type> offsets; // vertexNumber() + 1 entries into bytes
+    std::vector<std::uint8_t> bytes;
+    size_type edges = 0;
+};
+
+} // ! namespace graph
+
+#endif // GRAPH_COMPRESSED_GRAPH_HPP_INCLUDED
@@ -1,18 +1,117 @@
 #ifndef GRAPH_DETAIL_ADJACENCY_LIST_GRAPH_HPP
 #define GRAPH_DETAIL_ADJACENCY_LIST_GRAPH_HPP
 
-#include <list>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <stdexcept>
 
 namespace graph::detail {
 
+// adds vertices known to be new to a graph, for the algorithms that build graphs
+// out of distinct vertices, defined with partition
+struct VertexAppender;
+
 template <typename EdgeInfo>
 struct AdjacencyVertex {
-    AdjacencyVertex(std::size_t to, const EdgeInfo& e) : to(to), edge_info(e) { }
+    constexpr AdjacencyVertex(std::size_t to, const EdgeInfo& e) : to(to), edge_info(e) { }
 
     std::size_t to;
     EdgeInfo edge_info;
 };
 
+// A reference to an adjacency record stored as separate arrays
+// edge_info is only bound here, the payload is loaded when it is actually read
+template <typename EdgeInfo>
+struct AdjacencyVertexRef {
+    std::size_t to;
+    const EdgeInfo &edge_info;
+
+    operator AdjacencyVertex<EdgeInfo>() const {
+        return { to, edge_info };
+    }
+};
+
+// Key names a vertex by comparison with VertexInfo without being one, e.g. a
+// std::string_view or a string literal for std::string; ids keep the index overloads
+template <typename Key, typename VertexInfo>
+inline constexpr bool is_vertex_key_v = !std::is_same_v<std::remove_cv_t<std::remove_reference_t<Key>>, VertexInfo>
+        && !std::is_convertible_v<Key, std::size_t>;
+
+// a pair of vertices where at least one is such a key and neither is an id
+template <typename From, typename To, typename VertexInfo>
+inline constexpr bool is_vertex_key_pair_v = (is_vertex_key_v<From, VertexInfo> || is_vertex_key_v<To, VertexInfo>)
+        && !std::is_convertible_v<From, std::size_t> && !std::is_convertible_v<To, std::size_t>;
+
+// Wraps a payload so that a vector of it is contiguous for every type, including bool
+template <typename T>
+struct Boxed {
+    T value;
+};
+
+// A read only view of the adjacency of a vertex, stored as parallel arrays
+// of neighbor ids and edge payloads, iterated by Iterator, indexed by operator[]
+template <typename EdgeInfo, typename Iterator>
+class NeighborSpan {
+public:
+    using size_type = std::size_t;
+    using value_type = AdjacencyVertex<EdgeInfo>;
+    using reference = AdjacencyVertexRef<EdgeInfo>;
+    using iterator = Iterator;
+
+    NeighborSpan(const std::size_t *ids, const Boxed<EdgeInfo> *infos, size_type count)
+        : id_data(ids), info_data(infos), count(count) { }
+
+    iterator begin() const { return iterator(id_data, info_data); }
+    iterator end() const { return iterator(id_data + count, info_data + count); }
+    size_type size() const { return count; }
+    bool empty() const { return count == 0; }
+    reference operator[](size_type i) const { return { id_data[i], info_data[i].value }; }
+
+    // the contiguous neighbor ids, for scans that do not need the payload
+    const std::size_t *ids() const { return id_data; }
+    const EdgeInfo &edgeInfo(size_type i) const { return info_data[i].value; }
+
+    // the sub span [offset, offset + n), used to split a long adjacency across threads
+    NeighborSpan subspan(size_type offset, size_type n) const {
+        return NeighborSpan(id_data + offset, info_data + offset, n);
+    }
+
+private:
+    const std::size_t *id_data;
+    const Boxed<EdgeInfo> *info_data;
+    size_type count;
+};
+
+// A pair of iterators usable in a range based for
+template <typename Iterator>
+class IteratorRange {
+public:
+    using iterator = Iterator;
+
+    constexpr IteratorRange(Iterator first, Iterator last) : first(first), last(last) { }
+
+    constexpr iterator begin() const { return first; }
+    constexpr iterator end() const { return last; }
+    constexpr bool empty() const { return first == last; }
+
+private:
+    Iterator first, last;
+};
+
+// check old_to_new is a permutation of [0, n) and return its inverse
+inline std::vector<std::size_t> check_permutation(const std::vector<std::size_t> &old_to_new, std::size_t n) {
+    if (old_to_new.size() != n)
+        throw std::invalid_argument("Permutation size does not match vertex number");
+    std::vector<std::size_t> new_to_old(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (old_to_new[i] >= n || new_to_old[old_to_new[i]] != n)
+            throw std::invalid_argument("Not a permutation");
+        new_to_old[old_to_new[i]] = i;
+    }
+    return new_to_old;
+}
+
 } // ! namespace graph::detail
 
 #endif //GRAPH_DETAIL_ADJACENCY_LIST_GRAPH_HPP
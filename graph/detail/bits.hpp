@@ -0,0 +1,32 @@
+#ifndef GRAPH_DETAIL_BITS_HPP_INCLUDED
+#define GRAPH_DETAIL_BITS_HPP_INCLUDED
+
+#include <cstdint>
+
+namespace graph::detail {
+
+// index of the lowest set bit, x must not be 0
+constexpr int count_trailing_zeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while ((x & 1) == 0) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+constexpr int popcount(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    for (; x != 0; x &= x - 1)
+        ++n;
+    return n;
+#endif
+}
+
+} // ! namespace graph::detail
+
+#endif // GRAPH_DETAIL_BITS_HPP_INCLUDED
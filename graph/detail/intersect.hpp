@@ -0,0 +1,47 @@
+#ifndef GRAPH_DETAIL_INTERSECT_HPP
+#define GRAPH_DETAIL_INTERSECT_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace graph::detail {
+
+// first position in [first, first + n) not less than value, probing 1, 2, 4, ... ahead
+inline std::size_t gallop(const std::size_t *first, std::size_t n, std::size_t value) {
+    std::size_t low = 0, step = 1;
+    while (low + step < n && first[low + step] < value) {
+        low += step;
+        step *= 2;
+    }
+    return std::lower_bound(first + low, first + std::min(n, low + step + 1), value) - first;
+}
+
+// size of the intersection of two sorted id arrays
+// similar sizes use a branch free merge, skewed sizes gallop through the longer array
+inline std::size_t intersect_count(const std::size_t *a, std::size_t na, const std::size_t *b, std::size_t nb) {
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    std::size_t count = 0;
+    if (na * 32 < nb) {
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < na && j < nb; ++i) {
+            j += gallop(b + j, nb - j, a[i]);
+            count += j < nb && b[j] == a[i];
+        }
+        return count;
+    }
+    std::size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        std::size_t x = a[i], y = b[j];
+        count += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+    return count;
+}
+
+} // ! namespace graph::detail
+
+#endif // GRAPH_DETAIL_INTERSECT_HPP
@@ -0,0 +1,75 @@
+#ifndef GRAPH_DETAIL_PARALLEL_HPP
+#define GRAPH_DETAIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "../thread_pool.hpp"
+
+namespace graph::detail {
+
+inline std::size_t thread_number(std::size_t threads) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, threads);
+}
+
+// the pool every parallel loop runs on, started on first use
+inline ThreadPool &shared_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// call f(begin, end) on chunks of [0, n), chunks are claimed dynamically by the threads
+// the calling thread takes part, the others come from shared_pool(), so calls may nest
+template <typename F>
+void parallel_for(std::size_t n, std::size_t threads, F &&f, std::size_t grain = 1024) {
+    threads = std::min(thread_number(threads), (n + grain - 1) / grain);
+    if (threads <= 1) {
+        if (n != 0)
+            f(std::size_t(0), n);
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    auto work = [&]() {
+        for (std::size_t begin; (begin = next.fetch_add(grain)) < n; )
+            f(begin, std::min(n, begin + grain));
+    };
+    TaskGroup group(shared_pool());
+    for (std::size_t i = 1; i < threads; ++i)
+        group.submit(work);
+    work();
+    group.wait();
+}
+
+// sort chunks in parallel, then merge neighbouring runs pairwise
+template <typename Iterator, typename Compare>
+void parallel_sort(Iterator first, Iterator last, Compare comp, std::size_t threads = 0) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    std::size_t parts = std::min(thread_number(threads), std::max<std::size_t>(1, n / 4096));
+    if (parts <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+    std::size_t run = (n + parts - 1) / parts;
+    parallel_for(parts, parts, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p)
+            std::sort(first + std::min(n, p * run), first + std::min(n, (p + 1) * run), comp);
+    }, 1);
+    for (; run < n; run *= 2) {
+        std::size_t pairs = (n + 2 * run - 1) / (2 * run);
+        parallel_for(pairs, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t p = begin; p < end; ++p) {
+                std::size_t lo = p * 2 * run;
+                std::inplace_merge(first + lo, first + std::min(n, lo + run), first + std::min(n, lo + 2 * run), comp);
+            }
+        }, 1);
+    }
+}
+
+} // ! namespace graph::detail
+
+#endif // GRAPH_DETAIL_PARALLEL_HPP
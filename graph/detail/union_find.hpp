@@ -0,0 +1,84 @@
+#ifndef GRAPH_DETAIL_UNION_FIND_HPP
+#define GRAPH_DETAIL_UNION_FIND_HPP
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace graph::detail {
+
+// Disjoint sets with path compression and union by size
+class UnionFind {
+public:
+    using size_type = std::size_t;
+
+    explicit UnionFind(size_type n = 0) {
+        reset(n);
+    }
+
+    void reset(size_type n) {
+        parent.resize(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        sizes.assign(n, 1);
+    }
+
+    // grow to n elements, new elements are singletons
+    void extend(size_type n) {
+        for (size_type i = parent.size(); i < n; ++i) {
+            parent.push_back(i);
+            sizes.push_back(1);
+        }
+    }
+
+    // make x a singleton again, only valid if every element linked to x is detached too
+    void detach(size_type x) {
+        parent[x] = x;
+        sizes[x] = 1;
+    }
+
+    size_type size() const {
+        return parent.size();
+    }
+
+    size_type find(size_type x) {
+        size_type root = x;
+        while (parent[root] != root)
+            root = parent[root];
+        while (parent[x] != root) {
+            size_type next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    // returns false if a and b are already in the same set
+    bool unite(size_type a, size_type b) {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        if (sizes[a] < sizes[b])
+            std::swap(a, b);
+        parent[b] = a;
+        sizes[a] += sizes[b];
+        return true;
+    }
+
+    bool connected(size_type a, size_type b) {
+        return find(a) == find(b);
+    }
+
+    size_type setSize(size_type x) {
+        return sizes[find(x)];
+    }
+
+private:
+    std::vector<size_type> parent;
+    std::vector<size_type> sizes;
+};
+
+} // ! namespace graph::detail
+
+#endif // GRAPH_DETAIL_UNION_FIND_HPP
@@ -0,0 +1,162 @@
+#ifndef GRAPH_DYNAMIC_CONNECTIVITY_HPP_INCLUDED
+#define GRAPH_DYNAMIC_CONNECTIVITY_HPP_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "detail/union_find.hpp"
+
+namespace graph {
+
+// Connected components of an undirected graph kept up to date while it changes
+// edges are set through this object: an inserted edge merges two components in
+// near constant time, removed edges are collected and only the components they
+// touched are recomputed, lazily on the next query
+template <typename G>
+class IncrementalConnectivity {
+public:
+    static_assert(!G::is_directed, "Connectivity is maintained for undirected graphs");
+
+    using size_type = typename G::size_type;
+    using vertex_info_type = typename G::vertex_info_type;
+    using edge_info_type = typename G::edge_info_type;
+
+    explicit IncrementalConnectivity(G &g) : g(g), sets(get_vertex_number(g)), components(get_vertex_number(g)) {
+        for (size_type v = 0; v < get_vertex_number(g); ++v) {
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+                unite(v, (*beg).to);
+        }
+    }
+
+    const G &graph() const {
+        return g;
+    }
+
+    size_type addVertex(const vertex_info_type &v) {
+        auto index = g.addVertex(v);
+        sync();
+        return index;
+    }
+
+    void setEdge(const vertex_info_type &from, const vertex_info_type &to, const edge_info_type &e) {
+        setEdge(addVertex(from), addVertex(to), e);
+    }
+
+    void setEdge(size_type from, size_type to, const edge_info_type &e) {
+        bool existed = !(g.getEdge(from, to) == g.defaultEdgeInfo());
+        g.setEdge(from, to, e);
+        sync();
+        if (!(e == g.defaultEdgeInfo())) {
+            unite(from, to);
+        } else if (existed) {
+            removed.push_back(from);
+            removed.push_back(to);
+        }
+    }
+
+    void removeEdge(size_type from, size_type to) {
+        setEdge(from, to, g.defaultEdgeInfo());
+    }
+
+    // representative vertex of the component of v
+    size_type component(size_type v) {
+        refresh();
+        return sets.find(v);
+    }
+
+    bool connected(size_type a, size_type b) {
+        refresh();
+        return sets.connected(a, b);
+    }
+
+    size_type componentNumber() {
+        refresh();
+        return components;
+    }
+
+    size_type componentSize(size_type v) {
+        refresh();
+        return sets.setSize(v);
+    }
+
+    // recompute the components touched by removed edges now instead of on the next query
+    void refresh() {
+        sync();
+        if (removed.empty())
+            return;
+        // every piece of a split component contains an end of a removed edge,
+        // so searching from those ends covers all vertices of the touched components
+        visited.resize(get_vertex_number(g), false);
+        std::vector<size_type> roots;
+        for (auto v : removed) {
+            auto root = sets.find(v);
+            if (!visited[root]) {
+                visited[root] = true;
+                roots.push_back(root);
+            }
+        }
+        for (auto root : roots)
+            visited[root] = false;
+        components -= roots.size();
+
+        std::vector<size_type> affected;
+        std::vector<size_type> pieces; // index in affected where every piece starts
+        for (auto v : removed) {
+            if (visited[v])
+                continue;
+            visited[v] = true;
+            pieces.push_back(affected.size());
+            affected.push_back(v);
+            for (size_type head = pieces.back(); head < affected.size(); ++head) {
+                auto u = affected[head];
+                for (auto beg = g.adjacencyVertexBegin(u), end = g.adjacencyVertexEnd(u); beg != end; ++beg) {
+                    auto to = (*beg).to;
+                    if (!visited[to]) {
+                        visited[to] = true;
+                        affected.push_back(to);
+                    }
+                }
+            }
+        }
+        components += pieces.size();
+
+        // relink the touched vertices piece by piece
+        for (auto u : affected)
+            sets.detach(u);
+        pieces.push_back(affected.size());
+        for (size_type p = 0; p + 1 < pieces.size(); ++p) {
+            for (size_type i = pieces[p] + 1; i < pieces[p + 1]; ++i)
+                sets.unite(affected[pieces[p]], affected[i]);
+        }
+        for (auto u : affected)
+            visited[u] = false;
+        removed.clear();
+    }
+
+private:
+    void unite(size_type a, size_type b) {
+        if (sets.unite(a, b))
+            --components;
+    }
+
+    // pick up vertices added to the graph directly
+    void sync() {
+        auto n = get_vertex_number(g);
+        if (sets.size() < n) {
+            components += n - sets.size();
+            sets.extend(n);
+        }
+    }
+
+    G &g;
+    detail::UnionFind sets;
+    size_type components;
+    std::vector<size_type> removed; // ends of removed edges not processed yet
+    std::vector<bool> visited;      // all false between refreshes
+};
+
+} // ! namespace graph
+
+#endif // GRAPH_DYNAMIC_CONNECTIVITY_HPP_INCLUDED
@@ -0,0 +1,284 @@
+#ifndef GRAPH_EXTERNAL_HPP_INCLUDED
+#define GRAPH_EXTERNAL_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "detail/union_find.hpp"
+
+namespace graph {
+
+namespace detail {
+
+struct FileCloser {
+    void operator()(std::FILE *file) const {
+        if (file != nullptr)
+            std::fclose(file);
+    }
+};
+
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+inline File open_file(const std::string &path, const char *mode) {
+    File file(std::fopen(path.c_str(), mode));
+    if (!file)
+        throw std::runtime_error("Can not open edge file " + path);
+    return file;
+}
+
+} // ! namespace graph::detail
+
+// Graph whose arcs live in a file as consecutive pairs of 64 bit vertex ids
+// only vertex state is kept in memory, arcs are streamed in blocks of at most
+// blockBytes() bytes, so a file larger than the memory budget can be processed
+class ExternalEdgeList {
+public:
+    using size_type = std::size_t;
+    using arc_type = std::uint64_t[2];
+
+    ExternalEdgeList(std::string path, size_type vertex_number, size_type block_bytes = size_type(64) << 20)
+        : path(std::move(path)), vertex_number(vertex_number),
+          block_arcs(std::max<size_type>(1, block_bytes / sizeof(arc_type))) {
+        std::error_code error;
+        auto bytes = std::filesystem::file_size(this->path, error);
+        if (error)
+            throw std::runtime_error("Can not open edge file " + this->path);
+        if (bytes % sizeof(arc_type) != 0)
+            throw std::runtime_error("Malformed edge file " + this->path);
+        arc_number = static_cast<size_type>(bytes / sizeof(arc_type));
+    }
+
+    size_type vertexNumber() const {
+        return vertex_number;
+    }
+
+    size_type arcNumber() const {
+        return arc_number;
+    }
+
+    size_type blockBytes() const {
+        return block_arcs * sizeof(arc_type);
+    }
+
+    const std::string &filePath() const {
+        return path;
+    }
+
+    // call f(from, to) for every arc, reading the file sequentially block by block
+    template <typename F>
+    void forEachArc(F &&f) const {
+        auto file = detail::open_file(path, "rb");
+        std::vector<std::uint64_t> block(block_arcs * 2);
+        while (true) {
+            size_type read = std::fread(block.data(), sizeof(arc_type), block_arcs, file.get());
+            for (size_type i = 0; i < read; ++i) {
+                auto from = block[2 * i], to = block[2 * i + 1];
+                if (from >= vertex_number || to >= vertex_number)
+                    throw std::out_of_range("Vertex does not exist");
+                f(static_cast<size_type>(from), static_cast<size_type>(to));
+            }
+            if (read < block_arcs) {
+                if (std::ferror(file.get()))
+                    throw std::runtime_error("Can not read edge file " + path);
+                return;
+            }
+        }
+    }
+
+private:
+    std::string path;
+    size_type vertex_number;
+    size_type block_arcs;
+    size_type arc_number = 0;
+};
+
+// Appends arcs to an edge file through a fixed size buffer
+class ExternalEdgeListWriter {
+public:
+    using size_type = std::size_t;
+
+    explicit ExternalEdgeListWriter(std::string path, size_type buffer_bytes = size_type(4) << 20)
+        : path(std::move(path)), file(detail::open_file(this->path, "wb")),
+          capacity(std::max<size_type>(2, buffer_bytes / sizeof(std::uint64_t)) & ~size_type(1)) {
+        buffer.reserve(capacity);
+    }
+
+    ExternalEdgeListWriter(ExternalEdgeListWriter &&) = default;
+
+    // the arcs still buffered for the file written so far are flushed before it is closed
+    ExternalEdgeListWriter &operator=(ExternalEdgeListWriter &&other) {
+        if (this == &other)
+            return *this;
+        if (file)
+            flush();
+        path = std::move(other.path);
+        file = std::move(other.file);
+        capacity = other.capacity;
+        buffer = std::move(other.buffer);
+        vertex_number = other.vertex_number;
+        return *this;
+    }
+
+    // writes the arcs still buffered if close() was not called, errors can only be seen through close()
+    ~ExternalEdgeListWriter() {
+        if (!file)
+            return;
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+
+    void addArc(size_type from, size_type to) {
+        buffer.push_back(from);
+        buffer.push_back(to);
+        if (from >= vertex_number) vertex_number = from + 1;
+        if (to >= vertex_number) vertex_number = to + 1;
+        if (buffer.size() == capacity)
+            flush();
+    }
+
+    // finish the file, vertex_number defaults to one more than the largest id written
+    ExternalEdgeList close(size_type vertex_number = 0, size_type block_bytes = size_type(64) << 20) {
+        flush();
+        file.reset();
+        return ExternalEdgeList(path, std::max(vertex_number, this->vertex_number), block_bytes);
+    }
+
+private:
+    void flush() {
+        if (!file)
+            throw std::logic_error("Edge file is already closed");
+        if (std::fwrite(buffer.data(), sizeof(std::uint64_t), buffer.size(), file.get()) != buffer.size())
+            throw std::runtime_error("Can not write edge file " + path);
+        buffer.clear();
+    }
+
+    std::string path;
+    detail::File file;
+    size_type capacity;
+    std::vector<std::uint64_t> buffer;
+    size_type vertex_number = 0;
+};
+
+// Write every arc of g to path, edges equal to the default edge info are left out
+template <typename G>
+ExternalEdgeList write_edge_list(G &g, const std::string &path, std::size_t block_bytes = std::size_t(64) << 20) {
+    using size_type = typename G::size_type;
+    ExternalEdgeListWriter writer(path);
+    for (size_type i = 0; i < get_vertex_number(g); ++i) {
+        for (auto beg = g.adjacencyVertexBegin(i), end = g.adjacencyVertexEnd(i); beg != end; ++beg)
+            writer.addArc(i, (*beg).to);
+    }
+    return writer.close(get_vertex_number(g), block_bytes);
+}
+
+// Breadth first traverse an external graph with the roots and depths of breadth_first_traverse:
+// in every weakly connected component the roots are taken in index order, and a root
+// reaches what the earlier roots left; visit(edges, from, to) is called with from -1 for roots
+// all components advance together, every level costs one sequential scan of the file,
+// so an undirected graph takes 1 + (levels of its deepest component) scans; in a directed
+// graph every further root of a component with out arcs adds its own levels
+// within a level vertices are reported in file order, trees of different components interleave
+// returns the number of scans of the file
+template <typename Visit>
+std::size_t external_breadth_first_traverse(const ExternalEdgeList &edges, Visit &&visit) {
+    using size_type = ExternalEdgeList::size_type;
+    constexpr size_type unvisited = std::numeric_limits<size_type>::max();
+    size_type n = edges.vertexNumber();
+
+    std::vector<bool> has_out_arc(n, false);
+    detail::UnionFind sets(n);
+    edges.forEachArc([&](size_type from, size_type to) {
+        has_out_arc[from] = true;
+        sets.unite(from, to);
+    });
+
+    // components numbered by their smallest vertex, members of each in index order
+    std::vector<size_type> component_of(n), offsets(1, 0);
+    {
+        std::vector<size_type> number(n, unvisited);
+        for (size_type v = 0; v < n; ++v) {
+            auto &c = number[sets.find(v)];
+            if (c == unvisited) {
+                c = offsets.size() - 1;
+                offsets.push_back(0);
+            }
+            component_of[v] = c;
+            ++offsets[c + 1];
+        }
+    }
+    size_type components = offsets.size() - 1;
+    for (size_type c = 0; c < components; ++c)
+        offsets[c + 1] += offsets[c];
+    std::vector<size_type> members(n), next_root(offsets.begin(), offsets.end() - 1);
+    {
+        std::vector<size_type> position(offsets.begin(), offsets.end() - 1);
+        for (size_type v = 0; v < n; ++v)
+            members[position[component_of[v]]++] = v;
+    }
+
+    // level[v] is the scan in which v is expanded
+    std::vector<size_type> level(n, unvisited);
+    std::vector<bool> active(components, false); // the component has vertices to expand
+    for (size_type scan = 0; ; ++scan) {
+        bool any_active = false;
+        for (size_type c = 0; c < components; ++c) {
+            // a search that ended hands over to the next unvisited vertex as root,
+            // roots without out arcs end at once
+            while (!active[c] && next_root[c] != offsets[c + 1]) {
+                auto root = members[next_root[c]++];
+                if (level[root] != unvisited)
+                    continue;
+                level[root] = scan;
+                std::forward<Visit>(visit)(edges, std::make_signed_t<size_type>(-1), root);
+                active[c] = has_out_arc[root];
+            }
+            any_active = any_active || active[c];
+        }
+        if (!any_active)
+            return scan + 1;
+        std::fill(active.begin(), active.end(), false);
+        edges.forEachArc([&](size_type from, size_type to) {
+            if (level[from] == scan && level[to] == unvisited) {
+                level[to] = scan + 1;
+                std::forward<Visit>(visit)(edges, static_cast<std::make_signed_t<size_type>>(from), to);
+                if (has_out_arc[to])
+                    active[component_of[to]] = true;
+            }
+        });
+    }
+}
+
+// Weakly connected components of an external graph in one scan of the file
+// returns for every vertex the smallest vertex id of its component
+inline std::vector<std::size_t> external_connected_components(const ExternalEdgeList &edges) {
+    using size_type = ExternalEdgeList::size_type;
+    size_type n = edges.vertexNumber();
+    detail::UnionFind sets(n);
+    edges.forEachArc([&](size_type from, size_type to) { sets.unite(from, to); });
+    std::vector<size_type> smallest(n, n), res(n);
+    for (size_type v = 0; v < n; ++v) {
+        auto root = sets.find(v);
+        if (smallest[root] == n)
+            smallest[root] = v;
+        res[v] = smallest[root];
+    }
+    return res;
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_EXTERNAL_HPP_INCLUDED
@@ -9,6 +9,8 @@ namespace graph {
 template <typename VertexInfo, typename EdgeInfo = bool>
 using Edge = std::tuple<VertexInfo, VertexInfo, EdgeInfo>;
 
+// Base of every graph class, an edge set to the default edge info is no edge,
+// so adjacencyVertexBegin/End and neighbors never yield one
 template <bool IsDirected, typename VertexInfo, typename EdgeInfo = bool>
 struct GraphTag {
     static constexpr bool is_directed = IsDirected;
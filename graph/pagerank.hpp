@@ -0,0 +1,102 @@
+#ifndef GRAPH_PAGERANK_HPP_INCLUDED
+#define GRAPH_PAGERANK_HPP_INCLUDED
+
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "spmv.hpp"
+#include "detail/parallel.hpp"
+
+namespace graph {
+
+struct PageRankOptions {
+    double damping = 0.85;
+    double tolerance = 1e-6;         // stop when the L1 change of an iteration drops below
+    std::size_t max_iterations = 100;
+    std::size_t threads = 0;         // 0 for hardware concurrency
+    std::vector<double> personalization; // teleport distribution, empty for uniform
+};
+
+struct PageRankResult {
+    std::vector<double> ranks;
+    std::size_t iterations = 0;
+    double residual = 0;
+};
+
+// PageRank by power iteration with pull style SpMV over the in-edges
+// dangling vertices teleport by the personalization vector
+template <typename G>
+PageRankResult pagerank(G &g, const PageRankOptions &options = PageRankOptions()) {
+    auto in_edges = to_compressed_sparse_rows<double>(g, true, [](const auto &) { return 1.0; });
+    std::size_t n = in_edges.rows();
+    PageRankResult result;
+    if (n == 0)
+        return result;
+
+    std::vector<double> teleport(n, 1.0 / n);
+    if (!options.personalization.empty()) {
+        if (options.personalization.size() != n)
+            throw std::invalid_argument("Personalization size does not match vertex number");
+        double total = 0;
+        for (auto p : options.personalization)
+            total += p;
+        if (!(total > 0))
+            throw std::invalid_argument("Personalization must have a positive sum");
+        for (std::size_t i = 0; i < n; ++i)
+            teleport[i] = options.personalization[i] / total;
+    }
+
+    std::vector<double> inverse_out_degree(n, 0);
+    for (auto column : in_edges.columns)
+        inverse_out_degree[column] += 1;
+    for (auto &d : inverse_out_degree)
+        d = d == 0 ? 0 : 1 / d;
+
+    // the only buffers of the iteration, swapped instead of reallocated
+    std::vector<double> &ranks = result.ranks;
+    ranks = teleport;
+    std::vector<double> contribution(n), next(n);
+
+    std::mutex mutex;
+    for (result.iterations = 0; result.iterations < options.max_iterations; ) {
+        double dangling = 0;
+        detail::parallel_for(n, options.threads, [&](std::size_t begin, std::size_t end) {
+            double local = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                contribution[i] = ranks[i] * inverse_out_degree[i];
+                local += inverse_out_degree[i] == 0 ? ranks[i] : 0;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            dangling += local;
+        });
+
+        spmv_pull(in_edges, contribution, next, options.threads);
+
+        double residual = 0;
+        double base = 1 - options.damping + options.damping * dangling;
+        detail::parallel_for(n, options.threads, [&](std::size_t begin, std::size_t end) {
+            double local = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                next[i] = options.damping * next[i] + base * teleport[i];
+                local += std::fabs(next[i] - ranks[i]);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            residual += local;
+        });
+
+        ranks.swap(next);
+        ++result.iterations;
+        result.residual = residual;
+        if (residual < options.tolerance)
+            break;
+    }
+    return result;
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_PAGERANK_HPP_INCLUDED
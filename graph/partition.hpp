@@ -0,0 +1,228 @@
+#ifndef GRAPH_PARTITION_HPP_INCLUDED
+#define GRAPH_PARTITION_HPP_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+
+namespace graph {
+
+namespace detail {
+
+// the vertices of a part are distinct by construction, so they skip the lookup of addVertex
+struct VertexAppender {
+    template <typename G, typename V>
+    static typename G::size_type append(G &g, V &&v) {
+        return g.appendVertex(std::forward<V>(v));
+    }
+};
+
+} // ! namespace graph::detail
+
+enum class PartitionMethod {
+    LinearDeterministicGreedy, // neighbors in the part, damped by its fill ratio
+    Fennel,                    // neighbors in the part, minus a superlinear size penalty
+};
+
+// One part of a partitioned graph as a graph of its own
+// local vertices [0, owned) belong to the part, the rest are ghost copies of
+// the other endpoints of cut edges; in a directed graph the arcs entering the
+// part are kept too, from the ghost of their tail
+template <typename G>
+struct GraphPart {
+    G graph;
+    std::size_t owned = 0;
+    std::vector<std::size_t> local_to_global;
+};
+
+template <typename G>
+struct Partition {
+    std::size_t parts = 0;
+    std::vector<std::size_t> part_of; // part of every vertex
+    std::size_t edge_cut = 0;         // adjacency entries whose ends are in different parts
+    std::vector<GraphPart<G>> subgraphs;
+};
+
+// Assign every vertex to one of k parts in a single pass over the vertices
+// no part gets more than (1 + slack) * n / k vertices
+template <typename G>
+std::vector<std::size_t> streaming_partition(G &g, std::size_t k,
+        PartitionMethod method = PartitionMethod::LinearDeterministicGreedy, double slack = 0.05) {
+    using size_type = typename G::size_type;
+    if (k == 0)
+        throw std::invalid_argument("Number of parts must be positive");
+    size_type n = get_vertex_number(g);
+    auto capacity = static_cast<size_type>(std::ceil(static_cast<double>(n) / k * (1 + slack)));
+    capacity = std::max<size_type>(capacity, (n + k - 1) / k);
+
+    size_type m = 0;
+    if (method == PartitionMethod::Fennel) {
+        for (size_type v = 0; v < n; ++v) {
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+                ++m;
+        }
+    }
+    const double gamma = 1.5;
+    const double alpha = n == 0 ? 0 : std::sqrt(static_cast<double>(k)) * m / std::pow(static_cast<double>(n), gamma);
+
+    // directed graphs are partitioned as if undirected, so predecessors count as neighbors too
+    std::vector<std::vector<size_type>> predecessors(G::is_directed ? n : 0);
+    if constexpr (G::is_directed) {
+        for (size_type v = 0; v < n; ++v) {
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+                predecessors[(*beg).to].push_back(v);
+        }
+    }
+
+    constexpr size_type unassigned = std::numeric_limits<size_type>::max();
+    std::vector<size_type> part_of(n, unassigned), sizes(k, 0), neighbors_in(k, 0), touched;
+    auto count_neighbor = [&](size_type u) {
+        auto p = part_of[u];
+        if (p != unassigned && neighbors_in[p]++ == 0)
+            touched.push_back(p);
+    };
+    for (size_type v = 0; v < n; ++v) {
+        touched.clear();
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+            count_neighbor((*beg).to);
+        if constexpr (G::is_directed) {
+            for (auto u : predecessors[v])
+                count_neighbor(u);
+        }
+        size_type best = unassigned;
+        double best_score = 0;
+        for (size_type p = 0; p < k; ++p) {
+            if (sizes[p] >= capacity)
+                continue;
+            double score = method == PartitionMethod::Fennel
+                    ? neighbors_in[p] - alpha * gamma * std::pow(static_cast<double>(sizes[p]), gamma - 1)
+                    : neighbors_in[p] * (1 - static_cast<double>(sizes[p]) / capacity);
+            // ties go to the smaller part
+            if (best == unassigned || score > best_score || (score == best_score && sizes[p] < sizes[best])) {
+                best = p;
+                best_score = score;
+            }
+        }
+        part_of[v] = best;
+        ++sizes[best];
+        for (auto p : touched)
+            neighbors_in[p] = 0;
+    }
+    return part_of;
+}
+
+// Number of adjacency entries whose ends are in different parts
+template <typename G>
+std::size_t edge_cut(G &g, const std::vector<std::size_t> &part_of) {
+    using size_type = typename G::size_type;
+    size_type cut = 0;
+    for (size_type v = 0; v < get_vertex_number(g); ++v) {
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+            cut += part_of[(*beg).to] != part_of[v];
+    }
+    return cut;
+}
+
+// A old to new mapping that makes every part a contiguous id range, parts in order,
+// pass it to permuteVertices to lay the parts out as ranges (e.g. one per NUMA node)
+inline std::vector<std::size_t> partition_permutation(const std::vector<std::size_t> &part_of, std::size_t k) {
+    std::vector<std::size_t> first(k + 1, 0);
+    for (auto p : part_of)
+        ++first[p + 1];
+    for (std::size_t p = 0; p < k; ++p)
+        first[p + 1] += first[p];
+    std::vector<std::size_t> old_to_new(part_of.size());
+    for (std::size_t v = 0; v < part_of.size(); ++v)
+        old_to_new[v] = first[part_of[v]]++;
+    return old_to_new;
+}
+
+// Split g into k parts with a streaming heuristic and build the subgraph of every part
+template <typename G>
+Partition<G> partition(G &g, std::size_t k,
+        PartitionMethod method = PartitionMethod::LinearDeterministicGreedy, double slack = 0.05) {
+    using size_type = typename G::size_type;
+    Partition<G> res;
+    res.parts = k;
+    res.part_of = streaming_partition(g, k, method, slack);
+    res.edge_cut = edge_cut(g, res.part_of);
+
+    size_type n = get_vertex_number(g);
+    std::vector<size_type> local(n);
+    res.subgraphs.reserve(k);
+    for (size_type p = 0; p < k; ++p)
+        res.subgraphs.push_back(GraphPart<G>{ G(g.defaultEdgeInfo()), 0, {} });
+    for (size_type v = 0; v < n; ++v) {
+        auto &part = res.subgraphs[res.part_of[v]];
+        local[v] = part.owned++;
+        part.local_to_global.push_back(v);
+    }
+
+    std::vector<std::vector<size_type>> predecessors(G::is_directed ? n : 0);
+    if constexpr (G::is_directed) {
+        for (size_type v = 0; v < n; ++v) {
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+                predecessors[(*beg).to].push_back(v);
+        }
+    }
+
+    std::vector<size_type> ghost(n, n); // local id of a ghost in the part being built
+    for (size_type p = 0; p < k; ++p) {
+        auto &part = res.subgraphs[p];
+        auto local_id = [&](size_type v) {
+            if (res.part_of[v] == p)
+                return local[v];
+            if (ghost[v] == n) {
+                ghost[v] = part.local_to_global.size();
+                part.local_to_global.push_back(v);
+            }
+            return ghost[v];
+        };
+        // find the ghosts and count the edges first, so the part is allocated once
+        size_type inner = 0, cut = 0;
+        for (size_type i = 0; i < part.owned; ++i) {
+            auto v = part.local_to_global[i];
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+                auto to = (*beg).to;
+                local_id(to);
+                ++(res.part_of[to] == p ? inner : cut);
+            }
+            if constexpr (G::is_directed) {
+                for (auto u : predecessors[v]) {
+                    local_id(u);
+                    cut += res.part_of[u] != p;
+                }
+            }
+        }
+        part.graph.reserve(part.local_to_global.size(), G::is_directed ? inner + cut : inner / 2 + cut);
+        for (auto v : part.local_to_global)
+            detail::VertexAppender::append(part.graph, get_vertex(g, v));
+        for (size_type i = 0; i < part.owned; ++i) {
+            auto v = part.local_to_global[i];
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+                auto adjacency_info = *beg;
+                part.graph.setEdge(i, local_id(adjacency_info.to), adjacency_info.edge_info);
+            }
+            if constexpr (G::is_directed) {
+                for (auto u : predecessors[v]) {
+                    if (res.part_of[u] != p)
+                        part.graph.setEdge(ghost[u], i, g.getEdge(u, v));
+                }
+            }
+        }
+        for (size_type i = part.owned; i < part.local_to_global.size(); ++i)
+            ghost[part.local_to_global[i]] = n;
+    }
+    return res;
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_PARTITION_HPP_INCLUDED
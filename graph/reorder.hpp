@@ -0,0 +1,113 @@
+#ifndef GRAPH_REORDER_HPP_INCLUDED
+#define GRAPH_REORDER_HPP_INCLUDED
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+
+namespace graph {
+
+enum class ReorderMethod {
+    ReverseCuthillMcKee, // bandwidth reduction, neighbors get close ids
+    DegreeSort,          // descending degree, hot hubs are packed together
+};
+
+namespace detail {
+
+template <typename G>
+std::vector<typename G::size_type> out_degrees(G &g) {
+    using size_type = typename G::size_type;
+    std::vector<size_type> degrees(get_vertex_number(g), 0);
+    for (size_type i = 0; i < degrees.size(); ++i) {
+        for (auto beg = g.adjacencyVertexBegin(i), end = g.adjacencyVertexEnd(i); beg != end; ++beg)
+            ++degrees[i];
+    }
+    return degrees;
+}
+
+template <typename SizeType>
+std::vector<SizeType> invert_order(const std::vector<SizeType> &new_to_old) {
+    std::vector<SizeType> old_to_new(new_to_old.size());
+    for (SizeType i = 0; i < new_to_old.size(); ++i)
+        old_to_new[new_to_old[i]] = i;
+    return old_to_new;
+}
+
+} // ! namespace graph::detail
+
+// Reverse Cuthill-McKee order, returned as a old to new mapping
+// every component is started from its unvisited vertex of minimum degree
+template <typename G>
+std::vector<typename G::size_type> reverse_cuthill_mckee_order(G &g) {
+    using size_type = typename G::size_type;
+    auto degrees = detail::out_degrees(g);
+    size_type n = degrees.size();
+
+    std::vector<size_type> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+            [&](size_type a, size_type b) { return degrees[a] < degrees[b]; });
+
+    std::vector<bool> visited(n, false);
+    std::vector<size_type> order; // new to old
+    order.reserve(n);
+    std::vector<size_type> neighbors;
+    for (auto start : by_degree) {
+        if (visited[start])
+            continue;
+        visited[start] = true;
+        order.push_back(start);
+        for (size_type head = order.size() - 1; head < order.size(); ++head) {
+            auto v = order[head];
+            neighbors.clear();
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+                auto to = (*beg).to;
+                if (!visited[to]) {
+                    visited[to] = true;
+                    neighbors.push_back(to);
+                }
+            }
+            std::stable_sort(neighbors.begin(), neighbors.end(),
+                    [&](size_type a, size_type b) { return degrees[a] < degrees[b]; });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return detail::invert_order(order);
+}
+
+// Descending degree order, returned as a old to new mapping
+template <typename G>
+std::vector<typename G::size_type> degree_sort_order(G &g) {
+    using size_type = typename G::size_type;
+    auto degrees = detail::out_degrees(g);
+    std::vector<size_type> order(degrees.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+            [&](size_type a, size_type b) { return degrees[a] > degrees[b]; });
+    return detail::invert_order(order);
+}
+
+// Renumber the vertices of g for better traversal locality
+// returns the old to new mapping, vertex i of the old graph is vertex result[i] now
+template <typename G>
+std::vector<typename G::size_type> reorder(G &g, ReorderMethod method = ReorderMethod::ReverseCuthillMcKee) {
+    std::vector<typename G::size_type> old_to_new;
+    switch (method) {
+        case ReorderMethod::ReverseCuthillMcKee:
+            old_to_new = reverse_cuthill_mckee_order(g);
+            break;
+        case ReorderMethod::DegreeSort:
+            old_to_new = degree_sort_order(g);
+            break;
+    }
+    g.permuteVertices(old_to_new);
+    return old_to_new;
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_REORDER_HPP_INCLUDED
@@ -0,0 +1,137 @@
+#ifndef GRAPH_SPANNING_TREE_HPP_INCLUDED
+#define GRAPH_SPANNING_TREE_HPP_INCLUDED
+
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "spmv.hpp"
+#include "detail/parallel.hpp"
+#include "detail/union_find.hpp"
+
+namespace graph {
+
+namespace detail {
+
+// edges ordered by weight, ties broken by endpoints so every edge has a unique rank
+template <typename EdgeInfo>
+bool lighter_edge(const Edge<std::size_t, EdgeInfo> &a, const Edge<std::size_t, EdgeInfo> &b) {
+    if (std::get<2>(a) < std::get<2>(b)) return true;
+    if (std::get<2>(b) < std::get<2>(a)) return false;
+    return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+}
+
+template <typename G>
+std::vector<Edge<std::size_t, typename G::edge_info_type>> undirected_edges(G &g) {
+    using size_type = typename G::size_type;
+    std::vector<Edge<std::size_t, typename G::edge_info_type>> edges;
+    for (size_type i = 0; i < get_vertex_number(g); ++i) {
+        for (auto beg = g.adjacencyVertexBegin(i), end = g.adjacencyVertexEnd(i); beg != end; ++beg) {
+            auto adjacency_info = *beg;
+            if (i < adjacency_info.to)
+                edges.emplace_back(i, adjacency_info.to, adjacency_info.edge_info);
+        }
+    }
+    return edges;
+}
+
+} // ! namespace graph::detail
+
+// Minimum spanning forest by Kruskal, the edges are sorted in parallel
+// returns the forest edges (from, to, edge info) with from < to
+template <typename G>
+std::vector<Edge<std::size_t, typename G::edge_info_type>> minimum_spanning_forest(G &g, std::size_t threads = 0) {
+    static_assert(!G::is_directed, "Minimum spanning forest requires an undirected graph");
+    using EdgeInfo = typename G::edge_info_type;
+    auto edges = detail::undirected_edges(g);
+    detail::parallel_sort(edges.begin(), edges.end(), detail::lighter_edge<EdgeInfo>, threads);
+
+    detail::UnionFind sets(get_vertex_number(g));
+    std::vector<Edge<std::size_t, EdgeInfo>> forest;
+    for (auto &edge : edges) {
+        if (forest.size() + 1 == get_vertex_number(g))
+            break;
+        if (sets.unite(std::get<0>(edge), std::get<1>(edge)))
+            forest.push_back(std::move(edge));
+    }
+    return forest;
+}
+
+// Minimum spanning forest by Boruvka
+// every round all vertices look for their lightest edge leaving the component in parallel,
+// then the lightest edge of every component is contracted
+template <typename G>
+std::vector<Edge<std::size_t, typename G::edge_info_type>> minimum_spanning_forest_boruvka(G &g, std::size_t threads = 0) {
+    static_assert(!G::is_directed, "Minimum spanning forest requires an undirected graph");
+    using EdgeInfo = typename G::edge_info_type;
+    using EdgeType = Edge<std::size_t, EdgeInfo>;
+    constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    auto adjacency = to_compressed_sparse_rows<EdgeInfo>(g, false, [](const EdgeInfo &e) { return e; });
+    std::size_t n = adjacency.rows();
+    auto edge_of = [&](std::size_t v, std::size_t k) {
+        auto u = adjacency.columns[k];
+        return v < u ? EdgeType(v, u, adjacency.values[k]) : EdgeType(u, v, adjacency.values[k]);
+    };
+
+    detail::UnionFind sets(n);
+    std::vector<std::size_t> label(n), lightest(n), component_lightest(n, none);
+    std::vector<EdgeType> forest;
+    while (true) {
+        for (std::size_t v = 0; v < n; ++v)
+            label[v] = sets.find(v);
+
+        detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                lightest[v] = none;
+                for (std::size_t k = adjacency.offsets[v]; k < adjacency.offsets[v + 1]; ++k) {
+                    if (label[adjacency.columns[k]] == label[v])
+                        continue;
+                    if (lightest[v] == none || detail::lighter_edge(edge_of(v, k), edge_of(v, lightest[v])))
+                        lightest[v] = k;
+                }
+            }
+        });
+
+        std::vector<std::size_t> candidates; // vertices holding the lightest edge of their component
+        for (std::size_t v = 0; v < n; ++v) {
+            if (lightest[v] == none)
+                continue;
+            auto &best = component_lightest[label[v]];
+            if (best == none) {
+                best = v;
+                candidates.push_back(label[v]);
+            } else if (detail::lighter_edge(edge_of(v, lightest[v]), edge_of(best, lightest[best]))) {
+                best = v;
+            }
+        }
+        if (candidates.empty())
+            break;
+        for (auto c : candidates) {
+            auto v = component_lightest[c];
+            auto edge = edge_of(v, lightest[v]);
+            if (sets.unite(std::get<0>(edge), std::get<1>(edge)))
+                forest.push_back(std::move(edge));
+            component_lightest[c] = none;
+        }
+    }
+    return forest;
+}
+
+// Minimum spanning forest as a graph of the same type holding every vertex of g
+template <typename G>
+G minimum_spanning_forest_graph(G &g, std::size_t threads = 0) {
+    G forest(g.defaultEdgeInfo());
+    for (std::size_t i = 0; i < get_vertex_number(g); ++i)
+        forest.addVertex(get_vertex(g, i));
+    for (const auto &edge : minimum_spanning_forest(g, threads))
+        forest.setEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
+    return forest;
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_SPANNING_TREE_HPP_INCLUDED
@@ -0,0 +1,140 @@
+#ifndef GRAPH_SPMV_HPP_INCLUDED
+#define GRAPH_SPMV_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "detail/parallel.hpp"
+
+namespace graph {
+
+// A compressed sparse row snapshot of a graph adjacency
+// row i holds the edges leaving vertex i (entering it if transposed)
+template <typename Value = double>
+struct CompressedSparseRows {
+    using size_type = std::size_t;
+    using value_type = Value;
+
+    size_type rows() const {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    size_type nonZeros() const {
+        return columns.size();
+    }
+
+    std::vector<size_type> offsets; // rows() + 1 entries
+    std::vector<size_type> columns;
+    std::vector<Value> values;
+};
+
+// snapshot g
+// weight maps an edge info to the stored value
+template <typename Value, typename G, typename Weight>
+CompressedSparseRows<Value> to_compressed_sparse_rows(G &g, bool transpose, Weight &&weight) {
+    using size_type = typename G::size_type;
+    size_type n = get_vertex_number(g);
+    CompressedSparseRows<Value> res;
+    res.offsets.assign(n + 1, 0);
+
+    auto for_each_edge = [&](auto &&f) {
+        for (size_type i = 0; i < n; ++i) {
+            for (auto beg = g.adjacencyVertexBegin(i), end = g.adjacencyVertexEnd(i); beg != end; ++beg) {
+                auto adjacency_info = *beg;
+                f(i, adjacency_info.to, adjacency_info.edge_info);
+            }
+        }
+    };
+
+    for_each_edge([&](size_type from, size_type to, const auto &) {
+        ++res.offsets[(transpose ? to : from) + 1];
+    });
+    for (size_type i = 0; i < n; ++i)
+        res.offsets[i + 1] += res.offsets[i];
+    res.columns.resize(res.offsets[n]);
+    res.values.resize(res.offsets[n]);
+    std::vector<size_type> fill(res.offsets.begin(), res.offsets.end() - 1);
+    for_each_edge([&](size_type from, size_type to, const auto &e) {
+        auto row = transpose ? to : from;
+        auto position = fill[row]++;
+        res.columns[position] = transpose ? from : to;
+        res.values[position] = static_cast<Value>(weight(e));
+    });
+    return res;
+}
+
+template <typename Value = double, typename G>
+CompressedSparseRows<Value> to_compressed_sparse_rows(G &g, bool transpose = false) {
+    return to_compressed_sparse_rows<Value>(g, transpose, [](const auto &e) { return e; });
+}
+
+// y = A x, rows are split across threads, no synchronization on y is needed
+template <typename Value>
+void spmv_pull(const CompressedSparseRows<Value> &a, const std::vector<Value> &x, std::vector<Value> &y,
+        std::size_t threads = 0) {
+    if (x.size() < a.rows())
+        throw std::invalid_argument("Vector size does not match matrix");
+    y.resize(a.rows());
+    const auto *offsets = a.offsets.data();
+    const auto *columns = a.columns.data();
+    const auto *values = a.values.data();
+    const auto *in = x.data();
+    auto *out = y.data();
+    detail::parallel_for(a.rows(), threads, [=](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Value sum = 0;
+            for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+                sum += values[k] * in[columns[k]];
+            out[i] = sum;
+        }
+    });
+}
+
+// y = A^T x, every thread scatters its rows into a private buffer, the buffers are summed at last
+// scratch holds the private buffers and can be reused across calls
+template <typename Value>
+void spmv_push(const CompressedSparseRows<Value> &a, const std::vector<Value> &x, std::vector<Value> &y,
+        std::vector<std::vector<Value>> &scratch, std::size_t threads = 0) {
+    if (x.size() < a.rows())
+        throw std::invalid_argument("Vector size does not match matrix");
+    std::size_t n = a.rows();
+    std::size_t parts = detail::thread_number(threads);
+    scratch.resize(parts);
+    for (auto &buffer : scratch)
+        buffer.assign(n, 0);
+    std::size_t part_size = (n + parts - 1) / parts;
+    detail::parallel_for(parts, parts, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p) {
+            auto *out = scratch[p].data();
+            for (std::size_t i = p * part_size; i < std::min(n, (p + 1) * part_size); ++i) {
+                Value xi = x[i];
+                for (std::size_t k = a.offsets[i]; k < a.offsets[i + 1]; ++k)
+                    out[a.columns[k]] += a.values[k] * xi;
+            }
+        }
+    }, 1);
+    y.assign(n, 0);
+    detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+        for (const auto &buffer : scratch) {
+            const auto *in = buffer.data();
+            auto *out = y.data();
+            for (std::size_t i = begin; i < end; ++i)
+                out[i] += in[i];
+        }
+    });
+}
+
+template <typename Value>
+void spmv_push(const CompressedSparseRows<Value> &a, const std::vector<Value> &x, std::vector<Value> &y,
+        std::size_t threads = 0) {
+    std::vector<std::vector<Value>> scratch;
+    spmv_push(a, x, y, scratch, threads);
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_SPMV_HPP_INCLUDED
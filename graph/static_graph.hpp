@@ -0,0 +1,326 @@
+#ifndef GRAPH_STATIC_GRAPH_HPP_INCLUDED
+#define GRAPH_STATIC_GRAPH_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "detail/adjacency.hpp"
+#include "detail/bits.hpp"
+
+namespace graph {
+
+template <typename Graph> class StaticGraphAdjacencyIterator;
+
+namespace detail {
+
+template <std::size_t N>
+constexpr std::array<std::size_t, N> identity_array() {
+    std::array<std::size_t, N> res{};
+    for (std::size_t i = 0; i < N; ++i)
+        res[i] = i;
+    return res;
+}
+
+struct NoEdgeInfos { };
+
+} // ! namespace graph::detail
+
+// A graph of exactly N <= 64 vertices, identified by their index, stored inline
+// every row of the adjacency matrix is one 64 bit word, a bit is set iff the edge
+// differs from the default edge info, payloads other than bool live in an N x N array
+// nothing is allocated, so graphs can be built and traversed in constant expressions
+template <std::size_t N, bool IsDirected, typename EdgeInfo = bool>
+class StaticGraph : public GraphTag<IsDirected, std::size_t, EdgeInfo> {
+    static_assert(N <= 64, "StaticGraph holds at most 64 vertices");
+
+public:
+    using size_type = std::size_t;
+    using row_type = std::uint64_t;
+    using iterator = StaticGraphAdjacencyIterator<StaticGraph>;
+    using const_iterator = iterator;
+    using neighbor_range = detail::IteratorRange<iterator>;
+
+    constexpr explicit StaticGraph(const EdgeInfo &default_edge_info = detail::default_edge_info<EdgeInfo>)
+        : rows{}, infos{}, default_edge_info(default_edge_info) { }
+
+    constexpr const EdgeInfo& defaultEdgeInfo() const {
+        return default_edge_info;
+    }
+
+    constexpr size_type vertexNumber() const {
+        return N;
+    }
+
+    constexpr std::make_signed_t<size_type> indexOfVertex(size_type v) const {
+        return v < N ? static_cast<std::make_signed_t<size_type>>(v) : -1;
+    }
+
+    // the vertices are fixed, adding one only checks that it exists
+    constexpr size_type addVertex(size_type v) const {
+        if (v >= N)
+            throw std::out_of_range("Vertex does not exist");
+        return v;
+    }
+
+    constexpr const size_type& getVertex(size_type index) const {
+        return vertex_ids[index];
+    }
+
+    constexpr iterator adjacencyVertexBegin(size_type from) const {
+        return iterator(*this, from, adjacencyBits(from));
+    }
+
+    constexpr iterator adjacencyVertexEnd(size_type from) const {
+        return iterator(*this, from, 0);
+    }
+
+    constexpr neighbor_range neighbors(size_type from) const {
+        return neighbor_range(adjacencyVertexBegin(from), adjacencyVertexEnd(from));
+    }
+
+    // bit i is set iff the edge from -> i is not the default edge
+    constexpr row_type adjacencyBits(size_type from) const {
+        if (from >= N)
+            throw std::out_of_range("Vertex does not exist");
+        return rows[from];
+    }
+
+    constexpr size_type degree(size_type from) const {
+        return static_cast<size_type>(detail::popcount(adjacencyBits(from)));
+    }
+
+    constexpr void setEdge(size_type from, size_type to, const EdgeInfo &e) {
+        if (from >= N || to >= N)
+            throw std::out_of_range("Vertex does not exist");
+        setArc(from, to, e);
+        if constexpr (!IsDirected)
+            setArc(to, from, e);
+    }
+
+    constexpr EdgeInfo getEdge(size_type from, size_type to) const {
+        if (from >= N || to >= N)
+            throw std::out_of_range("Vertex does not exist");
+        return edgeAt(from, to);
+    }
+
+private:
+    friend iterator;
+
+    static constexpr std::array<size_type, N> vertex_ids = detail::identity_array<N>();
+    static constexpr bool boolean_edges = std::is_same_v<EdgeInfo, bool>;
+
+    constexpr void setArc(size_type from, size_type to, const EdgeInfo &e) {
+        if (e == default_edge_info) {
+            rows[from] &= ~(row_type(1) << to);
+            return;
+        }
+        rows[from] |= row_type(1) << to;
+        if constexpr (!boolean_edges)
+            infos[from][to] = e;
+    }
+
+    constexpr EdgeInfo edgeAt(size_type from, size_type to) const {
+        if ((rows[from] >> to & 1) == 0)
+            return default_edge_info;
+        if constexpr (boolean_edges)
+            return !default_edge_info;
+        else
+            return infos[from][to];
+    }
+
+    std::array<row_type, N> rows;
+    std::conditional_t<boolean_edges, detail::NoEdgeInfos, std::array<std::array<EdgeInfo, N>, N>> infos;
+    EdgeInfo default_edge_info;
+};
+
+// An iterator over the set bits of a row of a StaticGraph
+// dereferencing yields the {to, edge_info} record by value, so it is tagged as an input iterator
+template <typename Graph>
+class StaticGraphAdjacencyIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = detail::AdjacencyVertex<typename Graph::edge_info_type>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    constexpr StaticGraphAdjacencyIterator(const Graph &graph, std::size_t from, std::uint64_t remaining)
+        : graph(&graph), from(from), remaining(remaining) { }
+
+    constexpr StaticGraphAdjacencyIterator& operator++ () {
+        remaining &= remaining - 1;
+        return *this;
+    }
+
+    constexpr StaticGraphAdjacencyIterator operator++ (int) {
+        StaticGraphAdjacencyIterator res{*this};
+        remaining &= remaining - 1;
+        return res;
+    }
+
+    constexpr reference operator* () const {
+        std::size_t to = detail::count_trailing_zeros(remaining);
+        return { to, graph->edgeAt(from, to) };
+    }
+
+    constexpr bool operator== (const StaticGraphAdjacencyIterator &other) const {
+        return graph == other.graph && from == other.from && remaining == other.remaining;
+    }
+
+    constexpr bool operator!= (const StaticGraphAdjacencyIterator &other) const {
+        return !(*this == other);
+    }
+
+private:
+    const Graph* graph;
+    std::size_t from;
+    std::uint64_t remaining; // neighbors not reached yet
+};
+
+// The traversals below replace the generic ones for StaticGraph, found through
+// overload resolution; they visit in the same order, keep the visited set in one
+// word and the queue or stack in an array of N entries, so they are constexpr
+// they take the graph as const, the non const overloads after them exist only so
+// that a mutable graph does not bind to the generic G & versions instead
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename Visit>
+constexpr void breadth_first_traverse(const StaticGraph<N, IsDirected, EdgeInfo> &g, Visit&& visit) {
+    using size_type = std::size_t;
+    std::array<size_type, N> queue{};
+    std::array<std::make_signed_t<size_type>, N> parent{};
+    std::uint64_t visited = 0;
+    size_type tail = 0;
+    for (size_type i = 0; i < N; ++i) {
+        if (visited >> i & 1)
+            continue;
+        visited |= std::uint64_t(1) << i;
+        size_type head = tail;
+        queue[tail] = i;
+        parent[tail++] = -1;
+        while (head != tail) {
+            auto v = queue[head];
+            std::forward<Visit>(visit)(g, parent[head++], v);
+            auto next = g.adjacencyBits(v) & ~visited;
+            visited |= next;
+            for (; next != 0; next &= next - 1) {
+                queue[tail] = detail::count_trailing_zeros(next);
+                parent[tail++] = static_cast<std::make_signed_t<size_type>>(v);
+            }
+        }
+    }
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename Visit>
+constexpr void breadth_first_traverse_from(const StaticGraph<N, IsDirected, EdgeInfo> &g, std::size_t source,
+        std::size_t max_depth, Visit&& visit) {
+    using size_type = std::size_t;
+    if (source >= N)
+        throw std::out_of_range("Vertex does not exist");
+    std::array<size_type, N> queue{};
+    std::array<std::make_signed_t<size_type>, N> parent{};
+    std::uint64_t visited = std::uint64_t(1) << source;
+    size_type head = 0, tail = 0;
+    queue[tail] = source;
+    parent[tail++] = -1;
+    for (size_type depth = 0; head != tail; ++depth) {
+        for (size_type level_end = tail; head != level_end; ++head) {
+            auto v = queue[head];
+            std::forward<Visit>(visit)(g, parent[head], v, depth);
+            if (depth == max_depth)
+                continue;
+            auto next = g.adjacencyBits(v) & ~visited;
+            visited |= next;
+            for (; next != 0; next &= next - 1) {
+                queue[tail] = detail::count_trailing_zeros(next);
+                parent[tail++] = static_cast<std::make_signed_t<size_type>>(v);
+            }
+        }
+    }
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename Visit>
+constexpr void depth_first_traverse(const StaticGraph<N, IsDirected, EdgeInfo> &g, Visit&& visit) {
+    using size_type = std::size_t;
+    // the path from the root, with the neighbors every vertex on it has left to try
+    std::array<size_type, N> path{};
+    std::array<std::uint64_t, N> untried{};
+    std::uint64_t visited = 0;
+    for (size_type i = 0; i < N; ++i) {
+        if (visited >> i & 1)
+            continue;
+        visited |= std::uint64_t(1) << i;
+        visit(g, -1ll, static_cast<long long>(i));
+        size_type depth = 0;
+        path[0] = i;
+        untried[0] = g.adjacencyBits(i);
+        while (true) {
+            auto candidates = untried[depth] & ~visited;
+            if (candidates == 0) {
+                if (depth == 0)
+                    break;
+                --depth;
+                continue;
+            }
+            size_type to = detail::count_trailing_zeros(candidates);
+            untried[depth] = candidates & (candidates - 1);
+            visited |= std::uint64_t(1) << to;
+            visit(g, static_cast<long long>(path[depth]), static_cast<long long>(to));
+            path[++depth] = to;
+            untried[depth] = g.adjacencyBits(to);
+        }
+    }
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename VisitVertex>
+constexpr void depth_first_traverse_non_recursive(const StaticGraph<N, IsDirected, EdgeInfo> &g, VisitVertex&& visit_vertex) {
+    using size_type = std::size_t;
+    std::array<size_type, N> stack{};
+    std::uint64_t visited = 0;
+    for (size_type i = 0; i < N; ++i) {
+        if (visited >> i & 1)
+            continue;
+        visited |= std::uint64_t(1) << i;
+        size_type top = 0;
+        stack[top++] = i;
+        while (top != 0) {
+            auto v = stack[--top];
+            std::forward<VisitVertex>(visit_vertex)(g, v);
+            auto next = g.adjacencyBits(v) & ~visited;
+            visited |= next;
+            for (; next != 0; next &= next - 1)
+                stack[top++] = detail::count_trailing_zeros(next);
+        }
+    }
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename Visit>
+constexpr void breadth_first_traverse(StaticGraph<N, IsDirected, EdgeInfo> &g, Visit&& visit) {
+    breadth_first_traverse(std::as_const(g), std::forward<Visit>(visit));
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename Visit>
+constexpr void breadth_first_traverse_from(StaticGraph<N, IsDirected, EdgeInfo> &g, std::size_t source,
+        std::size_t max_depth, Visit&& visit) {
+    breadth_first_traverse_from(std::as_const(g), source, max_depth, std::forward<Visit>(visit));
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename Visit>
+constexpr void depth_first_traverse(StaticGraph<N, IsDirected, EdgeInfo> &g, Visit&& visit) {
+    depth_first_traverse(std::as_const(g), std::forward<Visit>(visit));
+}
+
+template <std::size_t N, bool IsDirected, typename EdgeInfo, typename VisitVertex>
+constexpr void depth_first_traverse_non_recursive(StaticGraph<N, IsDirected, EdgeInfo> &g, VisitVertex&& visit_vertex) {
+    depth_first_traverse_non_recursive(std::as_const(g), std::forward<VisitVertex>(visit_vertex));
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_STATIC_GRAPH_HPP_INCLUDED
@@ -0,0 +1,144 @@
+#ifndef GRAPH_TASK_SCHEDULER_HPP_INCLUDED
+#define GRAPH_TASK_SCHEDULER_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "thread_pool.hpp"
+
+namespace graph {
+
+// Shared flag to stop a running task graph, tasks not started yet are skipped
+class CancellationToken {
+public:
+    void cancel() {
+        flag.store(true, std::memory_order_relaxed);
+    }
+
+    bool cancelled() const {
+        return flag.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+struct TaskGraphResult {
+    std::size_t completed = 0;          // tasks that ran
+    std::size_t skipped = 0;            // tasks skipped after cancellation
+    std::size_t critical_path_length = 0; // tasks on the longest dependency chain
+    double critical_path_seconds = 0;   // measured run time along the slowest chain
+};
+
+// Run a dependency DAG on the pool, an edge u->v means v depends on u
+// run(g, v) is called for every vertex as soon as all its dependencies finished,
+// calls for independent vertices run concurrently, g must not be modified meanwhile
+// throws std::invalid_argument if g has a cycle, if a task throws the remaining
+// tasks are skipped and the first exception is rethrown
+template <typename G, typename Run>
+TaskGraphResult run_task_graph(G &g, Run &&run, ThreadPool &pool, CancellationToken *token = nullptr) {
+    static_assert(G::is_directed, "Task graph must be directed");
+    using size_type = typename G::size_type;
+    using clock = std::chrono::steady_clock;
+    size_type n = get_vertex_number(g);
+
+    auto successors = [&](size_type v, auto &&f) {
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+            f((*beg).to);
+    };
+
+    // in-degrees once, then a serial Kahn pass for cycle check and the critical path
+    std::vector<size_type> in_degree(n, 0);
+    for (size_type v = 0; v < n; ++v)
+        successors(v, [&](size_type to) { ++in_degree[to]; });
+    std::vector<size_type> order, depth(n, 1), remaining(in_degree);
+    order.reserve(n);
+    for (size_type v = 0; v < n; ++v) {
+        if (remaining[v] == 0)
+            order.push_back(v);
+    }
+    TaskGraphResult result;
+    for (size_type head = 0; head < order.size(); ++head) {
+        auto v = order[head];
+        result.critical_path_length = std::max(result.critical_path_length, depth[v]);
+        successors(v, [&](size_type to) {
+            depth[to] = std::max(depth[to], depth[v] + 1);
+            if (--remaining[to] == 0)
+                order.push_back(to);
+        });
+    }
+    if (order.size() != n)
+        throw std::invalid_argument("Task graph has a cycle");
+
+    std::unique_ptr<std::atomic<size_type>[]> pending(new std::atomic<size_type>[n]);
+    for (size_type v = 0; v < n; ++v)
+        pending[v].store(in_degree[v], std::memory_order_relaxed);
+    std::vector<double> seconds(n, 0);
+    std::atomic<size_type> completed{0}, skipped{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    CancellationToken failed;
+
+    std::function<void(size_type)> execute;
+    TaskGroup group(pool); // declared after execute, so its destructor waits before execute goes away
+    execute = [&](size_type v) {
+        if (failed.cancelled() || (token != nullptr && token->cancelled())) {
+            skipped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            auto start = clock::now();
+            try {
+                run(g, v);
+                completed.fetch_add(1, std::memory_order_relaxed);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                failed.cancel();
+                skipped.fetch_add(1, std::memory_order_relaxed);
+            }
+            seconds[v] = std::chrono::duration<double>(clock::now() - start).count();
+        }
+        // skipped tasks still release their dependents, so every vertex is reached
+        successors(v, [&](size_type to) {
+            if (pending[to].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                group.submit([&execute, to]() { execute(to); });
+        });
+    };
+    for (size_type v = 0; v < n; ++v) {
+        if (in_degree[v] == 0)
+            group.submit([&execute, v]() { execute(v); });
+    }
+    group.wait();
+    if (error)
+        std::rethrow_exception(error);
+
+    std::vector<double> finish(n, 0);
+    for (auto v : order) {
+        finish[v] += seconds[v];
+        result.critical_path_seconds = std::max(result.critical_path_seconds, finish[v]);
+        successors(v, [&](size_type to) { finish[to] = std::max(finish[to], finish[v]); });
+    }
+    result.completed = completed.load();
+    result.skipped = skipped.load();
+    return result;
+}
+
+template <typename G, typename Run>
+TaskGraphResult run_task_graph(G &g, Run &&run, CancellationToken *token = nullptr, std::size_t threads = 0) {
+    ThreadPool pool(threads);
+    return run_task_graph(g, std::forward<Run>(run), pool, token);
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_TASK_SCHEDULER_HPP_INCLUDED
@@ -0,0 +1,223 @@
+#ifndef GRAPH_THREAD_POOL_HPP_INCLUDED
+#define GRAPH_THREAD_POOL_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graph {
+
+class TaskGroup;
+
+// A work-stealing thread pool, tasks are submitted and waited for through a TaskGroup
+// every worker owns a deque, tasks submitted from a worker go to its own deque,
+// idle workers steal from the front of the others' deques
+class ThreadPool {
+public:
+    using size_type = std::size_t;
+    using task_type = std::function<void()>;
+
+    explicit ThreadPool(size_type threads = 0) {
+        if (threads == 0)
+            threads = std::max<size_type>(1, std::thread::hardware_concurrency());
+        for (size_type i = 0; i < threads; ++i)
+            queues.push_back(std::make_unique<WorkerQueue>());
+        for (size_type i = 0; i < threads; ++i)
+            workers.emplace_back([this, i]() { work(i); });
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        task_available.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    size_type threadNumber() const {
+        return workers.size();
+    }
+
+private:
+    friend class TaskGroup;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<task_type> tasks;
+    };
+
+    bool popOwn(size_type index, task_type &task) {
+        auto &queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_type index, task_type &task) {
+        for (size_type i = 1; i < queues.size(); ++i) {
+            auto &queue = *queues[(index + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void push(task_type task) {
+        size_type target = current_worker_pool == this
+                ? current_worker_index
+                : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++queued;
+        }
+        task_available.notify_one();
+    }
+
+    bool runOne(size_type index) {
+        task_type task;
+        if (!popOwn(index, task) && !steal(index, task))
+            return false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --queued;
+        }
+        task();
+        return true;
+    }
+
+    // run tasks until done() holds, sleeping while there is nothing to run
+    template <typename Done>
+    void helpUntil(Done &&done) {
+        size_type index = current_worker_pool == this ? current_worker_index : 0;
+        while (!done()) {
+            if (!runOne(index)) {
+                std::unique_lock<std::mutex> lock(mutex);
+                task_finished.wait(lock, [&]() { return done() || queued != 0; });
+            }
+        }
+    }
+
+    void notifyFinished() {
+        std::lock_guard<std::mutex> lock(mutex);
+        task_finished.notify_all();
+    }
+
+    void work(size_type index) {
+        current_worker_pool = this;
+        current_worker_index = index;
+        while (true) {
+            if (runOne(index))
+                continue;
+            std::unique_lock<std::mutex> lock(mutex);
+            task_available.wait(lock, [this]() { return stopping || queued != 0; });
+            if (stopping && queued == 0)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex; // guards queued and stopping, used by both condition variables
+    std::condition_variable task_available;
+    std::condition_variable task_finished; // a task of some group finished
+    size_type queued = 0;
+    bool stopping = false;
+
+    std::atomic<size_type> next_queue{0};
+
+    static inline thread_local ThreadPool *current_worker_pool = nullptr;
+    static inline thread_local size_type current_worker_index = 0;
+};
+
+// A batch of tasks on a pool that is waited for as a whole
+// wait() only waits for the tasks of this group, so a task may itself create a
+// group on the same pool and wait for it, the waiting thread runs tasks meanwhile
+// exceptions thrown by tasks are caught and rethrown by wait()
+class TaskGroup {
+public:
+    using size_type = ThreadPool::size_type;
+
+    explicit TaskGroup(ThreadPool &pool) : pool(pool) { }
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    // tasks still reference the group, so they are always waited for
+    ~TaskGroup() {
+        pool.helpUntil([this]() { return finished(); });
+    }
+
+    ThreadPool &threadPool() const {
+        return pool;
+    }
+
+    // may be called from a task of the group
+    template <typename F>
+    void submit(F &&f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.push([this, owner = &pool, task = std::forward<F>(f)]() mutable {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+            // the group may be gone once pending drops to 0, so only the pool is used after
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                owner->notifyFinished();
+        });
+    }
+
+    // block until every task of the group (including tasks submitted by them) finished
+    // if tasks threw, the others still run and the first exception is rethrown here
+    void wait() {
+        pool.helpUntil([this]() { return finished(); });
+        std::exception_ptr thrown;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            std::swap(thrown, error);
+        }
+        if (thrown)
+            std::rethrow_exception(thrown);
+    }
+
+private:
+    bool finished() const {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+
+    ThreadPool &pool;
+    std::atomic<size_type> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+} // ! namespace graph
+
+#endif // GRAPH_THREAD_POOL_HPP_INCLUDED
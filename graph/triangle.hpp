@@ -0,0 +1,187 @@
+#ifndef GRAPH_TRIANGLE_HPP_INCLUDED
+#define GRAPH_TRIANGLE_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+#include "algorithm.hpp"
+#include "detail/intersect.hpp"
+#include "detail/parallel.hpp"
+
+namespace graph {
+
+namespace detail {
+
+// G has neighbors(v).ids(), the contiguous sorted ids of an AdjacencyList row
+template <typename G, typename = void>
+struct has_neighbor_ids : std::false_type { };
+
+template <typename G>
+struct has_neighbor_ids<G, std::void_t<decltype(std::declval<const G &>().neighbors(std::size_t(0)).ids())>>
+    : std::true_type { };
+
+// G has decodeNeighbors(v, out), the bulk decoder of a CompressedGraph
+template <typename G, typename = void>
+struct has_decode_neighbors : std::false_type { };
+
+template <typename G>
+struct has_decode_neighbors<G, std::void_t<decltype(std::declval<const G &>().decodeNeighbors(
+        std::size_t(0), std::declval<std::vector<std::size_t> &>()))>> : std::true_type { };
+
+// sorted duplicate free neighbor ids of every vertex, a row may contain the vertex itself
+// rows either point into the graph or into storage
+struct SortedAdjacency {
+    std::vector<const std::size_t *> rows;
+    std::vector<std::size_t> degrees;
+    std::vector<std::size_t> storage;
+
+    std::size_t vertexNumber() const { return rows.size(); }
+    const std::size_t *row(std::size_t v) const { return rows[v]; }
+    std::size_t degree(std::size_t v) const { return degrees[v]; }
+    bool loop(std::size_t v) const { return std::binary_search(rows[v], rows[v] + degrees[v], v); }
+};
+
+// the rows of an AdjacencyList are borrowed as they are, those of a CompressedGraph
+// are decoded, others are gathered into one array and sorted in place
+template <typename G>
+SortedAdjacency sorted_adjacency(const G &g, std::size_t threads) {
+    using size_type = typename G::size_type;
+    size_type n = get_vertex_number(g);
+    SortedAdjacency res;
+    res.rows.resize(n);
+    res.degrees.resize(n);
+    if constexpr (has_neighbor_ids<G>::value) {
+        for (size_type v = 0; v < n; ++v) {
+            auto row = g.neighbors(v);
+            res.rows[v] = row.ids();
+            res.degrees[v] = row.size();
+        }
+        return res;
+    }
+    std::vector<size_type> offsets(n + 1, 0);
+    if constexpr (has_decode_neighbors<G>::value) {
+        std::vector<size_type> ids;
+        for (size_type v = 0; v < n; ++v) {
+            g.decodeNeighbors(v, ids);
+            res.storage.insert(res.storage.end(), ids.begin(), ids.end());
+            offsets[v + 1] = res.storage.size();
+            res.degrees[v] = ids.size();
+        }
+    } else {
+        for (size_type v = 0; v < n; ++v)
+            offsets[v + 1] = offsets[v] + static_cast<size_type>(std::distance(g.adjacencyVertexBegin(v), g.adjacencyVertexEnd(v)));
+        res.storage.resize(offsets[n]);
+        for (size_type v = 0; v < n; ++v) {
+            size_type k = offsets[v];
+            for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+                res.storage[k++] = (*beg).to;
+        }
+        parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                auto first = res.storage.begin() + offsets[v], last = res.storage.begin() + offsets[v + 1];
+                std::sort(first, last);
+                res.degrees[v] = std::unique(first, last) - first;
+            }
+        });
+    }
+    for (size_type v = 0; v < n; ++v)
+        res.rows[v] = res.storage.data() + offsets[v];
+    return res;
+}
+
+// only the edges towards higher (degree, id) ranked vertices, without self loops
+inline SortedAdjacency oriented_adjacency(const SortedAdjacency &adjacency) {
+    std::size_t n = adjacency.vertexNumber();
+    std::vector<std::size_t> degrees(n);
+    for (std::size_t v = 0; v < n; ++v)
+        degrees[v] = adjacency.degree(v) - adjacency.loop(v);
+    auto lower = [&](std::size_t a, std::size_t b) {
+        return degrees[a] < degrees[b] || (degrees[a] == degrees[b] && a < b);
+    };
+    SortedAdjacency res;
+    res.rows.resize(n);
+    res.degrees.assign(n, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        for (std::size_t k = 0; k < adjacency.degree(v); ++k)
+            res.degrees[v] += lower(v, adjacency.row(v)[k]);
+    }
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v)
+        offsets[v + 1] = offsets[v] + res.degrees[v];
+    res.storage.resize(offsets[n]);
+    for (std::size_t v = 0; v < n; ++v) {
+        std::size_t *out = res.storage.data() + offsets[v];
+        for (std::size_t k = 0; k < adjacency.degree(v); ++k) {
+            auto u = adjacency.row(v)[k];
+            if (lower(v, u))
+                *out++ = u;
+        }
+        res.rows[v] = res.storage.data() + offsets[v];
+    }
+    return res;
+}
+
+} // ! namespace graph::detail
+
+// Number of triangles of an undirected graph
+// edges are oriented from lower to higher degree, so every triangle is found once
+// by intersecting the out lists of the two ends of its lowest ranked edge
+template <typename G>
+std::size_t triangle_count(const G &g, std::size_t threads = 0) {
+    static_assert(!G::is_directed, "Triangle counting requires an undirected graph");
+    auto adjacency = detail::oriented_adjacency(detail::sorted_adjacency(g, threads));
+    std::size_t n = adjacency.vertexNumber();
+    std::atomic<std::size_t> total{0};
+    detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t local = 0;
+        for (std::size_t v = begin; v < end; ++v) {
+            const std::size_t *row_v = adjacency.row(v);
+            for (std::size_t k = 0; k < adjacency.degree(v); ++k) {
+                auto u = row_v[k];
+                local += detail::intersect_count(row_v, adjacency.degree(v), adjacency.row(u), adjacency.degree(u));
+            }
+        }
+        total.fetch_add(local, std::memory_order_relaxed);
+    }, 256);
+    return total.load();
+}
+
+// Local clustering coefficient of every vertex of an undirected graph:
+// the fraction of pairs of neighbors that are adjacent, 0 for degree below 2
+template <typename G>
+std::vector<double> local_clustering_coefficient(const G &g, std::size_t threads = 0) {
+    static_assert(!G::is_directed, "Clustering coefficient requires an undirected graph");
+    auto adjacency = detail::sorted_adjacency(g, threads);
+    std::size_t n = adjacency.vertexNumber();
+    std::vector<double> res(n, 0);
+    detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) {
+            bool loop_v = adjacency.loop(v);
+            std::size_t d = adjacency.degree(v) - loop_v;
+            if (d < 2)
+                continue;
+            const std::size_t *row_v = adjacency.row(v);
+            std::size_t links = 0; // every adjacent pair of neighbors is counted twice
+            for (std::size_t k = 0; k < adjacency.degree(v); ++k) {
+                auto u = row_v[k];
+                if (u == v)
+                    continue;
+                // the rows may share v and u themselves through self loops
+                links += detail::intersect_count(row_v, adjacency.degree(v), adjacency.row(u), adjacency.degree(u))
+                    - loop_v - adjacency.loop(u);
+            }
+            res[v] = static_cast<double>(links) / (static_cast<double>(d) * (d - 1));
+        }
+    }, 256);
+    return res;
+}
+
+} // ! namespace graph
+
+#endif // GRAPH_TRIANGLE_HPP_INCLUDED
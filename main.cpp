@@ -39,6 +39,11 @@ void test(Graph &g) {
     std::cout << '\n';
     graph::breadth_first_traverse(g, print_tree_edge);
     std::cout << '\n';
+    std::cout << "Within 2 hops:\t";
+    graph::breadth_first_traverse_from(g, 0, 2, [](auto &g, auto, auto to, auto depth) {
+        std::cout << graph::get_vertex(g, to) << '(' << depth << ") ";
+    });
+    std::cout << '\n';
 }
 
 template <typename Graph>
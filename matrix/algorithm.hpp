@@ -0,0 +1,128 @@
+#ifndef GRAPH_MATRIX_ALGORITHM_HPP_INCLUDED
+#define GRAPH_MATRIX_ALGORITHM_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "../graph/detail/parallel.hpp"
+
+namespace matrix_detail {
+
+// relax block (I, J) through the intermediate vertices of block K
+inline void floyd_warshall_block(std::vector<std::vector<double>> &d,
+        std::size_t i0, std::size_t j0, std::size_t k0, std::size_t block, std::size_t n) {
+    std::size_t i1 = std::min(n, i0 + block), j1 = std::min(n, j0 + block), k1 = std::min(n, k0 + block);
+    for (std::size_t k = k0; k < k1; ++k) {
+        const double *row_k = d[k].data();
+        for (std::size_t i = i0; i < i1; ++i) {
+            double *row_i = d[i].data();
+            double dik = row_i[k];
+            for (std::size_t j = j0; j < j1; ++j)
+                row_i[j] = std::min(row_i[j], dik + row_k[j]);
+        }
+    }
+}
+
+} // ! namespace matrix_detail
+
+// All pairs shortest paths by cache blocked Floyd-Warshall
+// m(i, j) is the length of edge i->j, infinity for no edge, keep the diagonal 0 for plain distances
+// in every round the diagonal block is done first, then its row and column, then all other blocks in parallel
+inline Matrix<double> floyd_warshall(const Matrix<double> &m, std::size_t threads = 0, std::size_t block = 64) {
+    if (m.rows() != m.columns())
+        throw std::invalid_argument("Floyd-Warshall requires a square matrix");
+    if (block == 0)
+        throw std::invalid_argument("Block size must be positive");
+    std::size_t n = m.rows();
+    std::vector<std::vector<double>> d = m.raw();
+    std::size_t blocks = (n + block - 1) / block;
+
+    for (std::size_t kb = 0; kb < blocks; ++kb) {
+        std::size_t k0 = kb * block;
+        matrix_detail::floyd_warshall_block(d, k0, k0, k0, block, n);
+
+        graph::detail::parallel_for(2 * blocks, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; ++t) {
+                std::size_t b = t / 2;
+                if (b == kb)
+                    continue;
+                if (t % 2 == 0)
+                    matrix_detail::floyd_warshall_block(d, k0, b * block, k0, block, n);
+                else
+                    matrix_detail::floyd_warshall_block(d, b * block, k0, k0, block, n);
+            }
+        }, 1);
+
+        graph::detail::parallel_for(blocks * blocks, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; ++t) {
+                std::size_t ib = t / blocks, jb = t % blocks;
+                if (ib == kb || jb == kb)
+                    continue;
+                matrix_detail::floyd_warshall_block(d, ib * block, jb * block, k0, block, n);
+            }
+        }, 1);
+    }
+    return Matrix<double>(std::move(d));
+}
+
+// Transitive closure by bit-parallel Warshall, rows are packed into 64 bit words
+// result(i, j) is true iff j is reachable from i by a non empty path
+inline Matrix<bool> transitive_closure(const Matrix<bool> &m, std::size_t threads = 0) {
+    if (m.rows() != m.columns())
+        throw std::invalid_argument("Transitive closure requires a square matrix");
+    constexpr std::size_t width = 64;
+    std::size_t n = m.rows();
+    std::size_t words = (n + width - 1) / width;
+
+    std::vector<std::uint64_t> bits(n * words, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            if (m(i, j))
+                bits[i * words + j / width] |= std::uint64_t(1) << (j % width);
+        }
+    }
+    auto test = [&](std::size_t i, std::size_t k) {
+        return (bits[i * words + k / width] >> (k % width)) & 1;
+    };
+    auto merge = [&](std::size_t i, std::size_t k) {
+        std::uint64_t *row_i = bits.data() + i * words;
+        const std::uint64_t *row_k = bits.data() + k * words;
+        for (std::size_t w = 0; w < words; ++w)
+            row_i[w] |= row_k[w];
+    };
+
+    // one round per word of intermediate vertices: close the rows of the round first,
+    // other rows only read them, so they can be updated in parallel
+    for (std::size_t kw = 0; kw < words; ++kw) {
+        std::size_t k0 = kw * width, k1 = std::min(n, k0 + width);
+        for (std::size_t k = k0; k < k1; ++k) {
+            for (std::size_t i = k0; i < k1; ++i) {
+                if (i != k && test(i, k))
+                    merge(i, k);
+            }
+        }
+        graph::detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                if (i >= k0 && i < k1)
+                    continue;
+                for (std::size_t k = k0; k < k1; ++k) {
+                    if (test(i, k))
+                        merge(i, k);
+                }
+            }
+        }, 64);
+    }
+
+    std::vector<std::vector<bool>> res(n, std::vector<bool>(n, false));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j)
+            res[i][j] = test(i, j);
+    }
+    return Matrix<bool>(std::move(res));
+}
+
+#endif // GRAPH_MATRIX_ALGORITHM_HPP_INCLUDED
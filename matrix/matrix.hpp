@@ -1,7 +1,9 @@
 #ifndef GRAPH_MATRIX_HPP_INCLUDED
 #define GRAPH_MATRIX_HPP_INCLUDED
 
+#include <algorithm>
 #include <vector>
+#include <stdexcept>
 
 template <typename T>
 class Matrix {
@@ -12,6 +14,16 @@ public:
     using const_reference =
         typename std::vector<T>::const_reference;
 
+    Matrix() = default;
+
+    // take over row major storage, every row must have the same length
+    explicit Matrix(std::vector<std::vector<T>> rows) : data(std::move(rows)) {
+        for (const auto &row : data) {
+            if (row.size() != columns())
+                throw std::invalid_argument("Rows of a matrix must have the same length");
+        }
+    }
+
     size_type rows() const {
         return data.size();
     }
@@ -23,13 +35,25 @@ public:
             return data[0].size();
     }
 
+    // capacity for n rows of m columns, later resizes within it do not reallocate
+    void reserve(size_type n, size_type m) {
+        data.reserve(n);
+        column_capacity = m;
+        for (auto &row : data)
+            row.reserve(m);
+    }
+
     void resize(size_type n, size_type m, const T &fill = T()) {
-        size_type old_rows = rows(), old_columns = columns();
-        if (n != old_rows)
-            data.resize(n, std::vector<T>(m, fill));
-        if (m != old_columns)
+        if (m != columns())
             for (auto &row : data)
                 row.resize(m, fill);
+        if (n < rows())
+            data.resize(n);
+        while (rows() < n) {
+            auto &row = data.emplace_back();
+            row.reserve(std::max(m, column_capacity));
+            row.resize(m, fill);
+        }
     }
 
     reference operator()(size_type i, size_type j) {
@@ -67,6 +91,7 @@ private:
     }
 
     std::vector<std::vector<T>> data;
+    size_type column_capacity = 0;
 };
 
 #endif // GRAPH_MATRIX_HPP_INCLUDED
@@ -0,0 +1,655 @@
+// Differential stress test: random graphs are built in every representation,
+// their edges, payloads and traversals must agree, and with --budgets building and
+// traversing them must also stay within time and memory budgets
+// usage: graph_stress [--budgets] [vertices] [edges] [seed] [threshold]
+// times are budgeted relative to plain reference kernels run on the same data in
+// the same process, so budgets hold in any build type; memory is budgeted relative
+// to the bytes the data needs; every budget is multiplied by threshold,
+// the run fails on any mismatch, and on any overrun when budgets are enforced
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/algorithm.hpp"
+#include "graph/adjacency_list.hpp"
+#include "graph/adjacency_matrix.hpp"
+#include "graph/compressed_graph.hpp"
+#include "graph/static_graph.hpp"
+
+// live heap bytes, to measure what a graph holds
+static std::atomic<long long> live_bytes{0};
+
+void *operator new(std::size_t size) {
+    auto *block = static_cast<std::max_align_t *>(std::malloc(size + sizeof(std::max_align_t)));
+    if (block == nullptr)
+        throw std::bad_alloc();
+    *reinterpret_cast<std::size_t *>(block) = size;
+    live_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return block + 1;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+    if (p == nullptr)
+        return;
+    auto *block = static_cast<std::max_align_t *>(p) - 1;
+    live_bytes.fetch_sub(static_cast<long long>(*reinterpret_cast<std::size_t *>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete[](void *p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+namespace {
+
+using vertex_info = long long;
+
+struct Options {
+    std::size_t vertices = 2000;
+    std::size_t edges = 20000;
+    std::uint64_t seed = 1;
+    double threshold = 1;
+    bool budgets = false; // without it budgets are only reported
+    std::size_t matrix_limit = 4000;   // larger graphs are not built as a matrix
+    std::size_t recursion_limit = 20000; // larger graphs skip the recursive DFS
+    std::size_t by_info_limit = 2000;  // larger graphs skip the linear vertex info lookups
+};
+
+int failures = 0;
+
+// time budget factors over the reference kernels, measured ratios are at most about
+// half of these in unoptimized and optimized builds alike
+constexpr double LIST_INSERT_FACTOR = 3.5;
+constexpr double COMPRESSED_BUILD_FACTOR = 3.5;
+constexpr double LIST_BFS_FACTOR = 15;   // the generic traversal goes through the queue adapter
+constexpr double COMPRESSED_BFS_FACTOR = 15;
+constexpr double STATIC_TRAVERSE_FACTOR = 0.5;
+
+void fail(const std::string &what) {
+    std::cout << "FAIL " << what << '\n';
+    ++failures;
+}
+
+// vertex infos differ from the indices, so mixing the two up is caught
+vertex_info info_of(std::size_t index) {
+    return static_cast<vertex_info>(index) * 3 + 1;
+}
+
+// best processor time of a few runs of f, processor time is not inflated while other
+// processes hold the cpu, and single runs of small graphs are too noisy to compare
+template <typename F>
+double best_seconds(F &&f, int repeats = 5) {
+    double best = 0;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::clock();
+        f();
+        double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+        best = i == 0 ? seconds : std::min(best, seconds);
+    }
+    return best;
+}
+
+// payload of the edges of the weighted graphs, 0 is the default edge info
+// an undirected edge gets the same payload from both ends
+template <bool IsDirected>
+int weight_of(std::size_t from, std::size_t to) {
+    if (!IsDirected && from > to)
+        std::swap(from, to);
+    return static_cast<int>((from * 7 + to * 3) % 5) + 1;
+}
+
+// order sensitive checksum of a traversal
+struct Trace {
+    std::uint64_t hash = 1469598103934665603ull;
+    std::size_t count = 0;
+
+    void add(long long value) {
+        hash = (hash ^ static_cast<std::uint64_t>(value)) * 1099511628211ull;
+        ++count;
+    }
+
+    bool operator== (const Trace &other) const {
+        return hash == other.hash && count == other.count;
+    }
+
+    bool operator!= (const Trace &other) const {
+        return !(*this == other);
+    }
+};
+
+// value and reference are in the same unit, value may be at most factor times reference
+void check_budget(const std::string &what, double value, double reference, double factor, const char *unit,
+        const Options &options) {
+    double budget = reference * factor * options.threshold;
+    std::cout << std::left << std::setw(36) << what << std::right << std::setw(12) << std::fixed
+              << std::setprecision(2) << value << ' ' << unit << " (reference " << reference
+              << ", budget " << budget << ")" << (options.budgets ? "" : " not enforced") << '\n';
+    if (options.budgets && value > budget)
+        fail(what + " over budget");
+}
+
+template <typename G>
+Trace breadth_first_trace(G &g) {
+    Trace trace;
+    graph::breadth_first_traverse(g, [&](auto &, auto from, auto to) {
+        trace.add(from);
+        trace.add(static_cast<long long>(to));
+    });
+    return trace;
+}
+
+template <typename G>
+Trace depth_first_trace(G &g) {
+    Trace trace;
+    graph::depth_first_traverse(g, [&](auto &, auto from, auto to) {
+        trace.add(from);
+        trace.add(static_cast<long long>(to));
+    });
+    return trace;
+}
+
+template <typename G>
+Trace non_recursive_trace(G &g) {
+    Trace trace;
+    graph::depth_first_traverse_non_recursive(g, [&](auto &, auto v) { trace.add(static_cast<long long>(v)); });
+    return trace;
+}
+
+template <typename G>
+Trace reachable_trace(G &g, std::size_t source, std::size_t max_depth) {
+    Trace trace;
+    graph::breadth_first_traverse_from(g, source, max_depth, [&](auto &, auto from, auto to, auto depth) {
+        trace.add(from);
+        trace.add(static_cast<long long>(to));
+        trace.add(static_cast<long long>(depth));
+    });
+    return trace;
+}
+
+// neighbors of v by index and by vertex info must be the same sorted list
+template <typename G, typename H>
+bool same_neighbors(G &g, H &h, std::size_t v) {
+    auto beg = h.adjacencyVertexBegin(v), end = h.adjacencyVertexEnd(v);
+    for (auto a = g.adjacencyVertexBegin(v), b = g.adjacencyVertexEnd(v); a != b; ++a, ++beg) {
+        if (beg == end || (*a).to != (*beg).to || !(*a).edge_info || !(*beg).edge_info)
+            return false;
+    }
+    return beg == end;
+}
+
+// the same neighbors with equal payloads
+template <typename G, typename H>
+bool same_weighted_neighbors(G &g, H &h, std::size_t v) {
+    auto beg = h.adjacencyVertexBegin(v), end = h.adjacencyVertexEnd(v);
+    for (auto a = g.adjacencyVertexBegin(v), b = g.adjacencyVertexEnd(v); a != b; ++a, ++beg) {
+        if (beg == end || (*a).to != (*beg).to || (*a).edge_info != (*beg).edge_info)
+            return false;
+    }
+    return beg == end;
+}
+
+// breadth first traversal of plain compressed rows, the reference for the traversal budgets
+struct ReferenceRows {
+    std::vector<std::size_t> offsets, ids;
+
+    template <typename G>
+    explicit ReferenceRows(const G &g) : offsets(1, 0) {
+        std::size_t n = graph::get_vertex_number(g);
+        offsets.reserve(n + 1);
+        for (std::size_t v = 0; v < n; ++v) {
+            auto row = g.neighbors(v);
+            ids.insert(ids.end(), row.ids(), row.ids() + row.size());
+            offsets.push_back(ids.size());
+        }
+    }
+
+    Trace breadthFirst() const {
+        std::size_t n = offsets.size() - 1;
+        Trace trace;
+        std::vector<char> visited(n, 0);
+        std::vector<std::size_t> queue(n);
+        std::vector<long long> parent(n);
+        std::size_t tail = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (visited[i])
+                continue;
+            visited[i] = 1;
+            std::size_t head = tail;
+            queue[tail] = i;
+            parent[tail++] = -1;
+            while (head != tail) {
+                auto v = queue[head];
+                trace.add(parent[head++]);
+                trace.add(static_cast<long long>(v));
+                for (std::size_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+                    auto u = ids[k];
+                    if (!visited[u]) {
+                        visited[u] = 1;
+                        queue[tail] = u;
+                        parent[tail++] = static_cast<long long>(v);
+                    }
+                }
+            }
+        }
+        return trace;
+    }
+};
+
+// gap encoding of every row as varints written byte by byte, the reference for the compressed build
+template <typename G>
+std::vector<std::uint8_t> reference_encode(const G &g) {
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::size_t> ids;
+    auto put = [&](std::uint64_t x) {
+        for (; x >= 0x80; x >>= 7)
+            bytes.push_back(static_cast<std::uint8_t>(x | 0x80));
+        bytes.push_back(static_cast<std::uint8_t>(x));
+    };
+    for (std::size_t v = 0; v < graph::get_vertex_number(g); ++v) {
+        auto row = g.neighbors(v);
+        ids.assign(row.ids(), row.ids() + row.size());
+        std::sort(ids.begin(), ids.end());
+        put(ids.size());
+        for (std::size_t k = 0; k < ids.size(); ++k)
+            put(k == 0 ? ids[0] : ids[k] - ids[k - 1] - 1);
+    }
+    return bytes;
+}
+
+template <typename G>
+bool same_neighbors_by_info(G &g, std::size_t v) {
+    auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v);
+    for (auto a = g.adjacencyVertexBegin(graph::get_vertex(g, v)), b = g.adjacencyVertexEnd(graph::get_vertex(g, v));
+         a != b; ++a, ++beg) {
+        if (beg == end || (*a).to != (*beg).to)
+            return false;
+    }
+    return beg == end;
+}
+
+template <bool IsDirected>
+void run(const Options &options) {
+    const char *kind = IsDirected ? "directed" : "undirected";
+    std::cout << "== " << kind << ' ' << options.vertices << " vertices, " << options.edges << " edges\n";
+    std::mt19937_64 rng(options.seed + IsDirected);
+    std::uniform_int_distribution<std::size_t> pick(0, options.vertices - 1);
+    std::size_t n = options.vertices;
+
+    // the same operations are replayed on every representation
+    struct Operation { std::size_t from, to; bool set; };
+    std::vector<Operation> operations;
+    operations.reserve(options.edges + options.edges / 8);
+    for (std::size_t i = 0; i < options.edges; ++i) {
+        operations.push_back({ pick(rng), pick(rng), true });
+        if (i % 8 == 7) // remove an earlier edge now and then
+            operations.push_back({ operations[i / 2].from, operations[i / 2].to, false });
+    }
+
+    // reference: sorted id vectors updated in place, no payloads
+    double reference_insert_seconds = best_seconds([&]() {
+        std::vector<std::vector<std::size_t>> rows(n);
+        auto set_arc = [&](std::size_t from, std::size_t to, bool set) {
+            auto &row = rows[from];
+            auto it = std::lower_bound(row.begin(), row.end(), to);
+            bool present = it != row.end() && *it == to;
+            if (set && !present)
+                row.insert(it, to);
+            else if (!set && present)
+                row.erase(it);
+        };
+        for (auto &operation : operations) {
+            set_arc(operation.from, operation.to, operation.set);
+            if (!IsDirected)
+                set_arc(operation.to, operation.from, operation.set);
+        }
+    });
+
+    // the vertices are added once, their lookups are not part of the edge insertion budget
+    graph::AdjacencyList<IsDirected, vertex_info> vertices_only;
+    for (std::size_t v = 0; v < n; ++v)
+        vertices_only.addVertex(info_of(v));
+    auto memory_before = live_bytes.load();
+    graph::AdjacencyList<IsDirected, vertex_info> list;
+    double list_seconds = best_seconds([&]() {
+        graph::AdjacencyList<IsDirected, vertex_info>().swap(list);
+        memory_before = live_bytes.load();
+        list = vertices_only;
+        list.reserve(n, options.edges);
+        for (auto &operation : operations)
+            list.setEdge(operation.from, operation.to, operation.set);
+    });
+    auto list_bytes = live_bytes.load() - memory_before;
+
+    std::size_t arcs = 0;
+    for (std::size_t v = 0; v < n; ++v)
+        arcs += list.neighbors(v).size();
+    std::cout << "arcs " << arcs << '\n';
+    double per_arc = 1.0 / std::max<std::size_t>(arcs, 1);
+
+    ReferenceRows reference(list);
+    std::size_t reference_bytes = 0;
+    double reference_build_seconds = best_seconds([&]() { reference_bytes = reference_encode(list).size(); });
+
+    memory_before = live_bytes.load();
+    graph::CompressedGraph<IsDirected, vertex_info> compressed;
+    double compressed_seconds = best_seconds([&]() {
+        compressed = graph::CompressedGraph<IsDirected, vertex_info>();
+        memory_before = live_bytes.load();
+        compressed = graph::CompressedGraph<IsDirected, vertex_info>(list);
+    });
+    auto compressed_bytes = live_bytes.load() - memory_before;
+
+    // edges, through every lookup path
+    if (compressed.edgeNumber() != arcs || compressed.compressedBytes() != reference_bytes)
+        fail("compressed edge number");
+    for (std::size_t v = 0; v < n; ++v) {
+        if (!same_neighbors(list, compressed, v)) {
+            fail(std::string("compressed neighbors of ") + std::to_string(v));
+            break;
+        }
+    }
+    // the bulk decoder, which the triangle kernels read compressed rows with
+    std::vector<std::size_t> decoded(1, n);
+    for (std::size_t v = 0; v < n; ++v) {
+        auto row = list.neighbors(v);
+        compressed.decodeNeighbors(v, decoded);
+        if (decoded.size() != row.size() || !std::equal(decoded.begin(), decoded.end(), row.ids())) {
+            fail(std::string("compressed decoded neighbors of ") + std::to_string(v));
+            break;
+        }
+    }
+    std::size_t samples = std::max<std::size_t>(10, std::min<std::size_t>(1000, 20000000 / n));
+    for (std::size_t i = 0; i < samples; ++i) {
+        // half of the pairs were set at some point, so edges are sampled as well as non edges
+        const auto &operation = operations[pick(rng) % operations.size()];
+        auto a = i % 2 == 0 ? pick(rng) : operation.from;
+        auto b = i % 2 == 0 ? pick(rng) : operation.to;
+        bool expected = list.getEdge(a, b);
+        if (compressed.getEdge(a, b) != expected)
+            fail("compressed getEdge");
+        if (list.getEdge(info_of(a), info_of(b)) != expected || compressed.getEdge(info_of(a), info_of(b)) != expected)
+            fail("getEdge by vertex info");
+        if (!same_neighbors_by_info(list, a) || !same_neighbors_by_info(compressed, a))
+            fail("adjacency by vertex info");
+    }
+
+    // traversals must visit in the same order everywhere
+    Trace bfs, compressed_bfs, reference_bfs;
+    double bfs_seconds = best_seconds([&]() { bfs = breadth_first_trace(list); });
+    double compressed_bfs_seconds = best_seconds([&]() { compressed_bfs = breadth_first_trace(compressed); });
+    double reference_bfs_seconds = best_seconds([&]() { reference_bfs = reference.breadthFirst(); });
+    if (bfs.count != 2 * n || compressed_bfs != bfs || reference_bfs != bfs)
+        fail("breadth first traverse");
+    auto non_recursive = non_recursive_trace(list);
+    if (non_recursive.count != n || non_recursive_trace(compressed) != non_recursive)
+        fail("depth first traverse non recursive");
+    Trace dfs;
+    if (n <= options.recursion_limit) {
+        dfs = depth_first_trace(list);
+        if (dfs.count != 2 * n || depth_first_trace(compressed) != dfs)
+            fail("depth first traverse");
+    }
+    for (std::size_t max_depth = 0; max_depth < 8; ++max_depth) {
+        auto source = pick(rng);
+        if (reachable_trace(compressed, source, max_depth) != reachable_trace(list, source, max_depth))
+            fail("breadth first traverse from " + std::to_string(source));
+    }
+
+    if (n <= options.matrix_limit) {
+        graph::AdjacencyMatrix<IsDirected, vertex_info> matrix;
+        matrix.reserve(n, options.edges);
+        for (std::size_t v = 0; v < n; ++v)
+            matrix.addVertex(info_of(v));
+        for (auto &operation : operations)
+            matrix.setEdge(operation.from, operation.to, operation.set);
+        for (std::size_t v = 0; v < n; ++v) {
+            if (!same_neighbors(list, matrix, v)) {
+                fail(std::string("matrix neighbors of ") + std::to_string(v));
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < samples; ++i) {
+            auto a = pick(rng), b = pick(rng);
+            if (matrix.getEdge(a, b) != list.getEdge(a, b) || matrix.getEdge(info_of(a), info_of(b)) != list.getEdge(a, b))
+                fail("matrix getEdge");
+            if (!same_neighbors_by_info(matrix, a))
+                fail("matrix adjacency by vertex info");
+        }
+        if (breadth_first_trace(matrix) != bfs || non_recursive_trace(matrix) != non_recursive)
+            fail("matrix traversals");
+        if (n <= options.recursion_limit && depth_first_trace(matrix) != dfs)
+            fail("matrix depth first traverse");
+    }
+
+    // the same operations with int payloads, payloads must match wherever they are read
+    graph::AdjacencyList<IsDirected, vertex_info, int> weighted(0);
+    weighted.reserve(n, options.edges);
+    for (std::size_t v = 0; v < n; ++v)
+        weighted.addVertex(info_of(v));
+    for (auto &operation : operations)
+        weighted.setEdge(operation.from, operation.to, operation.set ? weight_of<IsDirected>(operation.from, operation.to) : 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        auto row = weighted.neighbors(v), expected = list.neighbors(v);
+        bool same = row.size() == expected.size();
+        for (std::size_t k = 0; same && k < row.size(); ++k) {
+            same = row.ids()[k] == expected.ids()[k] && row[k].edge_info == row.edgeInfo(k)
+                && row.edgeInfo(k) == weight_of<IsDirected>(v, row.ids()[k]);
+        }
+        if (!same) {
+            fail(std::string("weighted neighbors of ") + std::to_string(v));
+            break;
+        }
+    }
+    if (breadth_first_trace(weighted) != bfs)
+        fail("weighted breadth first traverse");
+    graph::CompressedGraph<IsDirected, vertex_info> weighted_compressed(weighted);
+    for (std::size_t v = 0; v < n; ++v) {
+        if (!same_neighbors(compressed, weighted_compressed, v)) {
+            fail("compressed weighted graph");
+            break;
+        }
+    }
+    if (n <= options.matrix_limit) {
+        graph::AdjacencyMatrix<IsDirected, vertex_info, int> weighted_matrix(0);
+        weighted_matrix.reserve(n);
+        for (std::size_t v = 0; v < n; ++v)
+            weighted_matrix.addVertex(info_of(v));
+        for (auto &operation : operations) {
+            weighted_matrix.setEdge(operation.from, operation.to,
+                                    operation.set ? weight_of<IsDirected>(operation.from, operation.to) : 0);
+        }
+        for (std::size_t v = 0; v < n; ++v) {
+            if (!same_weighted_neighbors(weighted, weighted_matrix, v)) {
+                fail(std::string("weighted matrix neighbors of ") + std::to_string(v));
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < samples; ++i) {
+            auto a = pick(rng), b = pick(rng);
+            if (weighted_matrix.getEdge(a, b) != weighted.getEdge(a, b))
+                fail("weighted matrix getEdge");
+        }
+    }
+
+    // the same graph built through vertex infos only
+    if (n <= options.by_info_limit) {
+        graph::AdjacencyList<IsDirected, vertex_info> by_info;
+        for (std::size_t v = 0; v < n; ++v)
+            graph::add_vertex(by_info, info_of(v));
+        for (auto &operation : operations)
+            graph::set_edge(by_info, info_of(operation.from), info_of(operation.to), operation.set);
+        if (breadth_first_trace(by_info) != bfs || non_recursive_trace(by_info) != non_recursive)
+            fail("graph built by vertex info");
+    }
+
+    // the list also keeps the payloads sorted with the ids, and mirrors undirected edges itself
+    check_budget(std::string(kind) + " list edge insertion", list_seconds * 1e9 * per_arc,
+                 reference_insert_seconds * 1e9 * per_arc, LIST_INSERT_FACTOR, "ns/arc", options);
+    // the compressed build sorts and encodes every row the reference only copies
+    check_budget(std::string(kind) + " compressed build", compressed_seconds * 1e9 * per_arc,
+                 reference_build_seconds * 1e9 * per_arc, COMPRESSED_BUILD_FACTOR, "ns/arc", options);
+    check_budget(std::string(kind) + " list bfs", bfs_seconds * 1e9 * per_arc,
+                 reference_bfs_seconds * 1e9 * per_arc, LIST_BFS_FACTOR, "ns/arc", options);
+    check_budget(std::string(kind) + " compressed bfs", compressed_bfs_seconds * 1e9 * per_arc,
+                 reference_bfs_seconds * 1e9 * per_arc, COMPRESSED_BFS_FACTOR, "ns/arc", options);
+    // the ids and boxed payloads themselves plus the vertex records, the rest is vector slack
+    double list_ideal = static_cast<double>(arcs) * (sizeof(std::size_t) + sizeof(graph::detail::Boxed<bool>))
+        + static_cast<double>(n) * sizeof(graph::AdjacencyListVertex<vertex_info>);
+    check_budget(std::string(kind) + " list memory", static_cast<double>(list_bytes) * per_arc,
+                 list_ideal * per_arc, 2, "B/arc", options);
+    double compressed_ideal = static_cast<double>(compressed.compressedBytes())
+        + static_cast<double>(n) * (sizeof(vertex_info) + sizeof(std::size_t));
+    check_budget(std::string(kind) + " compressed memory", static_cast<double>(compressed_bytes) * per_arc,
+                 compressed_ideal * per_arc, 1.25, "B/arc", options);
+}
+
+// many small random graphs as StaticGraph, checked against AdjacencyList
+template <bool IsDirected>
+void run_static(const Options &options) {
+    constexpr std::size_t n = 64;
+    std::mt19937_64 rng(options.seed * 31 + IsDirected);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    std::size_t rounds = 200;
+    double fixed_seconds = 0, list_seconds = 0;
+    for (std::size_t round = 0; round < rounds; ++round) {
+        graph::StaticGraph<n, IsDirected> fixed;
+        graph::AdjacencyList<IsDirected, vertex_info> list;
+        graph::StaticGraph<n, IsDirected, int> weighted_fixed(0);
+        graph::AdjacencyList<IsDirected, vertex_info, int> weighted_list(0);
+        for (std::size_t v = 0; v < n; ++v) {
+            list.addVertex(info_of(v));
+            weighted_list.addVertex(info_of(v));
+        }
+        std::size_t edges = round % 160;
+        for (std::size_t i = 0; i < edges; ++i) {
+            auto a = pick(rng), b = pick(rng);
+            bool set = i % 5 != 4;
+            fixed.setEdge(a, b, set);
+            list.setEdge(a, b, set);
+            weighted_fixed.setEdge(a, b, set ? weight_of<IsDirected>(a, b) : 0);
+            weighted_list.setEdge(a, b, set ? weight_of<IsDirected>(a, b) : 0);
+        }
+        for (std::size_t v = 0; v < n; ++v) {
+            if (!same_neighbors(list, fixed, v) || fixed.degree(v) != list.neighbors(v).size())
+                fail("static graph neighbors");
+            if (!same_weighted_neighbors(weighted_list, weighted_fixed, v))
+                fail("weighted static graph neighbors");
+            for (std::size_t u = 0; u < n; ++u) {
+                if (fixed.getEdge(v, u) != list.getEdge(v, u))
+                    fail("static graph getEdge");
+                if (weighted_fixed.getEdge(v, u) != weighted_list.getEdge(v, u))
+                    fail("weighted static graph getEdge");
+            }
+        }
+        Trace fixed_traces[4], list_traces[4];
+        auto trace_all = [&](auto &g, Trace *traces) {
+            traces[0] = breadth_first_trace(g);
+            traces[1] = depth_first_trace(g);
+            traces[2] = non_recursive_trace(g);
+            traces[3] = reachable_trace(g, round % n, round % 4);
+        };
+        fixed_seconds += best_seconds([&]() { trace_all(fixed, fixed_traces); });
+        list_seconds += best_seconds([&]() { trace_all(list, list_traces); });
+        for (int k = 0; k < 4; ++k) {
+            if (fixed_traces[k] != list_traces[k])
+                fail("static graph traversals");
+        }
+        if (failures > 0)
+            return;
+    }
+    // the bit parallel traversals should not lose to the list they replace
+    check_budget(std::string(IsDirected ? "directed" : "undirected") + " static graph traversals",
+                 fixed_seconds * 1e6 / rounds, list_seconds * 1e6 / rounds, STATIC_TRAVERSE_FACTOR, "us/round", options);
+}
+
+// rows mixing runs of consecutive ids with wide gaps, so the bulk decoder of
+// CompressedGraph takes both its word at a time path and its varint path
+void run_decode(const Options &options) {
+    std::mt19937_64 rng(options.seed * 17 + 5);
+    std::size_t n = 5000;
+    graph::AdjacencyList<true, vertex_info> list;
+    for (std::size_t v = 0; v < n; ++v)
+        list.addVertex(info_of(v));
+    for (std::size_t v = 0; v < n; ++v) {
+        std::size_t to = rng() % 64;
+        while (to < n) {
+            std::size_t run = rng() % 24;
+            for (std::size_t k = 0; k < run && to < n; ++k)
+                list.setEdge(v, to++, true);
+            to += 1 + rng() % (v % 3 == 0 ? 200000 : 300);
+        }
+    }
+    graph::CompressedGraph<true, vertex_info> compressed(list);
+    std::vector<std::size_t> decoded;
+    for (std::size_t v = 0; v < n; ++v) {
+        auto row = list.neighbors(v);
+        compressed.decodeNeighbors(v, decoded);
+        if (decoded.size() != row.size() || !std::equal(decoded.begin(), decoded.end(), row.ids())
+                || !same_neighbors(list, compressed, v)) {
+            fail(std::string("decoded neighbors of ") + std::to_string(v));
+            return;
+        }
+    }
+}
+
+} // ! namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (argc > 1 && std::string(argv[1]) == "--budgets") {
+        options.budgets = true;
+        --argc;
+        ++argv;
+    }
+    try {
+        if (argc > 1) options.vertices = std::stoull(argv[1]);
+        if (argc > 2) options.edges = std::stoull(argv[2]);
+        if (argc > 3) options.seed = std::stoull(argv[3]);
+        if (argc > 4) options.threshold = std::stod(argv[4]);
+    } catch (const std::exception &) {
+        std::cout << "usage: " << argv[0] << " [--budgets] [vertices] [edges] [seed] [threshold]\n";
+        return 2;
+    }
+    if (options.vertices == 0) {
+        std::cout << "graph needs at least one vertex\n";
+        return 2;
+    }
+
+    try {
+        run<false>(options);
+        run<true>(options);
+        run_static<false>(options);
+        run_static<true>(options);
+        run_decode(options);
+    } catch (const std::exception &e) {
+        fail(std::string("exception: ") + e.what());
+    }
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "all checks passed\n";
+    return 0;
+}
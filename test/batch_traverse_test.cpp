@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "check.hpp"
+#include "random_graph.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/batch_traverse.hpp"
+#include "../graph/thread_pool.hpp"
+
+using Graph = graph::AdjacencyList<true, long long>;
+using Reached = std::vector<std::tuple<std::size_t, std::size_t, std::size_t>>; // query, vertex, depth
+
+Reached one_by_one(Graph &g, const std::vector<std::size_t> &sources, std::size_t max_depth) {
+    Reached res;
+    for (std::size_t q = 0; q < sources.size(); ++q) {
+        graph::breadth_first_traverse_from(g, sources[q], max_depth, [&](auto &, auto, std::size_t to, std::size_t depth) {
+            res.emplace_back(q, to, depth);
+        });
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+// with fail set, the first visit at depth 2 throws and clears it, so that a failed
+// and a clean run share the visitor type and with it the workspace of the thread
+Reached batched(Graph &g, const std::vector<std::size_t> &sources, std::size_t max_depth, graph::ThreadPool &pool,
+        bool *fail = nullptr) {
+    Reached res;
+    std::mutex mutex;
+    graph::breadth_first_traverse_batch(g, sources, max_depth, [&](auto &, std::size_t q, std::size_t v, std::size_t depth) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fail != nullptr && *fail && depth == 2) {
+            *fail = false;
+            throw std::runtime_error("visit failed");
+        }
+        res.emplace_back(q, v, depth);
+    }, pool);
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+int main() {
+    graph::ThreadPool pool(4);
+    auto g = graph_test::random_graph<Graph>(500, 1500, 1);
+    std::vector<std::size_t> sources;
+    for (std::size_t i = 0; i < 150; ++i) // three batches, repeated sources included
+        sources.push_back((i * 37) % 500);
+
+    // batches agree with one traversal per source
+    for (std::size_t max_depth : { 0, 1, 3, 1000 }) {
+        auto expected = one_by_one(g, sources, max_depth);
+        CHECK(batched(g, sources, max_depth, pool) == expected);
+    }
+    Reached serial;
+    std::mutex serial_mutex;
+    graph::breadth_first_traverse_batch(g, sources, 2, [&](auto &, std::size_t q, std::size_t v, std::size_t depth) {
+        std::lock_guard<std::mutex> lock(serial_mutex);
+        serial.emplace_back(q, v, depth);
+    }, 1);
+    std::sort(serial.begin(), serial.end());
+    CHECK(serial == one_by_one(g, sources, 2));
+    CHECK_THROWS(batched(g, { 0, 500 }, 1, pool), std::out_of_range);
+
+    // a throwing visit reaches the caller and leaves the pool usable
+    CHECK_THROWS(graph::breadth_first_traverse_batch(g, sources, 2, [](auto &, std::size_t q, std::size_t, std::size_t) {
+        if (q == 100)
+            throw std::runtime_error("visit failed");
+    }, pool), std::runtime_error);
+    CHECK(batched(g, sources, 2, pool) == one_by_one(g, sources, 2));
+
+    // the same visitor throwing once mid level on one thread leaves nothing behind for the next run
+    graph::ThreadPool single(1);
+    Graph path;
+    for (long long v = 0; v < 10; ++v)
+        path.addVertex(v);
+    for (std::size_t v = 0; v + 1 < 10; ++v)
+        path.setEdge(v, v + 1, true);
+    for (auto *run_on : { &path, &g }) {
+        std::vector<std::size_t> starts = run_on == &path ? std::vector<std::size_t>{ 0, 0, 3 } : sources;
+        bool fail = true;
+        CHECK_THROWS(batched(*run_on, starts, 1000, single, &fail), std::runtime_error);
+        CHECK(!fail);
+        for (int k = 0; k < 3; ++k)
+            CHECK(batched(*run_on, starts, 1000, single, &fail) == one_by_one(*run_on, starts, 1000));
+    }
+    CHECK(batched(path, { 0 }, 1000, single).size() == 10);
+
+    // groups nest: tasks wait for their own groups on the same pool
+    for (auto *p : { &pool, &single }) {
+        std::atomic<std::size_t> done{0};
+        bool nested_equal = true;
+        std::mutex mutex;
+        graph::TaskGroup outer(*p);
+        for (std::size_t i = 0; i < 6; ++i) {
+            outer.submit([&]() {
+                graph::TaskGroup inner(*p);
+                for (std::size_t j = 0; j < 10; ++j)
+                    inner.submit([&]() { ++done; });
+                inner.wait();
+                auto res = batched(g, sources, 1, *p);
+                std::lock_guard<std::mutex> lock(mutex);
+                nested_equal = nested_equal && res == one_by_one(g, sources, 1);
+            });
+        }
+        outer.wait();
+        CHECK(done == 60);
+        CHECK(nested_equal);
+    }
+    return graph_test::report();
+}
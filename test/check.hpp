@@ -0,0 +1,45 @@
+#ifndef GRAPH_TEST_CHECK_HPP_INCLUDED
+#define GRAPH_TEST_CHECK_HPP_INCLUDED
+
+#include <iostream>
+
+// Minimal checks for the test executables, unlike assert they stay on in release builds
+namespace graph_test {
+
+inline int &failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool ok, const char *what, const char *file, int line) {
+    if (ok)
+        return;
+    std::cout << file << ':' << line << ": check failed: " << what << '\n';
+    ++failures();
+}
+
+// exit code of a test executable
+inline int report() {
+    if (failures() != 0) {
+        std::cout << failures() << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // ! namespace graph_test
+
+#define CHECK(condition) ::graph_test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_THROWS(expression, exception_type)                                      \
+    do {                                                                              \
+        bool thrown_ = false;                                                         \
+        try {                                                                         \
+            expression;                                                               \
+        } catch (const exception_type &) {                                            \
+            thrown_ = true;                                                           \
+        }                                                                             \
+        ::graph_test::check(thrown_, #expression " throws " #exception_type, __FILE__, __LINE__); \
+    } while (0)
+
+#endif // GRAPH_TEST_CHECK_HPP_INCLUDED
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "check.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/dynamic_connectivity.hpp"
+
+using Graph = graph::AdjacencyList<false, long long>;
+
+// component label of every vertex by a fresh search
+std::vector<std::size_t> naive_components(Graph &g) {
+    std::size_t n = get_vertex_number(g);
+    std::vector<std::size_t> label(n, n);
+    for (std::size_t root = 0; root < n; ++root) {
+        if (label[root] != n)
+            continue;
+        graph::breadth_first_traverse_from(g, root, n, [&](auto &, auto, std::size_t v, auto) { label[v] = root; });
+    }
+    return label;
+}
+
+template <typename G>
+std::vector<std::size_t> reached_from(G &g, std::size_t source) {
+    std::vector<std::size_t> res;
+    graph::breadth_first_traverse_from(g, source, get_vertex_number(g), [&](auto &, auto, std::size_t v, auto) {
+        res.push_back(v);
+    });
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+// removing an edge takes it out of the adjacency, traversals no longer follow it
+template <typename G>
+void check_remove_edge() {
+    G g;
+    for (long long v = 0; v < 6; ++v)
+        g.addVertex(v * 10);
+    std::size_t path[] = { 0, 1, 2, 3 };
+    for (std::size_t i = 0; i + 1 < 4; ++i)
+        graph::add_edge(g, path[i], path[i + 1]);
+    graph::add_edge(g, std::size_t(4), std::size_t(5));
+    CHECK((reached_from(g, 0) == std::vector<std::size_t>{ 0, 1, 2, 3 }));
+
+    graph::remove_edge(g, std::size_t(1), std::size_t(2));
+    CHECK(!g.getEdge(std::size_t(1), std::size_t(2)));
+    CHECK((reached_from(g, 0) == std::vector<std::size_t>{ 0, 1 }));
+    if constexpr (!G::is_directed) {
+        CHECK(!g.getEdge(std::size_t(2), std::size_t(1)));
+        CHECK((reached_from(g, 3) == std::vector<std::size_t>{ 2, 3 }));
+    } else {
+        CHECK((reached_from(g, 2) == std::vector<std::size_t>{ 2, 3 }));
+    }
+    std::size_t degree = 0;
+    for (auto beg = g.adjacencyVertexBegin(std::size_t(1)), end = g.adjacencyVertexEnd(std::size_t(1)); beg != end; ++beg)
+        degree += (*beg).to == 2;
+    CHECK(degree == 0);
+
+    // removed by vertex info, and removing it again changes nothing
+    graph::remove_edge(g, 40ll, 50ll);
+    graph::remove_edge(g, 40ll, 50ll);
+    CHECK((reached_from(g, 4) == std::vector<std::size_t>{ 4 }));
+
+    graph::add_edge(g, std::size_t(1), std::size_t(2));
+    CHECK((reached_from(g, 0) == std::vector<std::size_t>{ 0, 1, 2, 3 }));
+}
+
+void check_connectivity(unsigned seed) {
+    std::mt19937 rng(seed);
+    Graph g;
+    std::size_t n = 40;
+    for (std::size_t v = 0; v < n; ++v)
+        g.addVertex(static_cast<long long>(v));
+    // some edges before the structure exists
+    for (std::size_t i = 0; i < 20; ++i)
+        g.setEdge(std::size_t(rng() % n), std::size_t(rng() % n), true);
+    graph::IncrementalConnectivity<Graph> connectivity(g);
+    std::vector<std::pair<std::size_t, std::size_t>> inserted;
+
+    for (std::size_t step = 0; step < 600; ++step) {
+        std::size_t op = rng() % 10;
+        std::size_t a = rng() % get_vertex_number(g), b = rng() % get_vertex_number(g);
+        if (op < 4) {
+            connectivity.setEdge(a, b, true);
+            inserted.emplace_back(a, b);
+        } else if (op < 7 && !inserted.empty()) {
+            // removals of present edges, plus now and then one that is gone already
+            auto k = rng() % inserted.size();
+            connectivity.removeEdge(inserted[k].first, inserted[k].second);
+            if (op != 6) {
+                inserted[k] = inserted.back();
+                inserted.pop_back();
+            }
+        } else if (op == 7 && step % 50 == 7) {
+            // vertices added through the structure or behind its back are both picked up
+            if (step % 100 == 7)
+                connectivity.addVertex(static_cast<long long>(get_vertex_number(g)));
+            else
+                g.addVertex(static_cast<long long>(get_vertex_number(g)));
+        } else {
+            auto label = naive_components(g);
+            std::size_t components = 0, size_a = 0;
+            for (std::size_t v = 0; v < label.size(); ++v) {
+                components += label[v] == v;
+                size_a += label[v] == label[a];
+            }
+            CHECK(connectivity.connected(a, b) == (label[a] == label[b]));
+            CHECK((connectivity.component(a) == connectivity.component(b)) == (label[a] == label[b]));
+            CHECK(connectivity.componentNumber() == components);
+            CHECK(connectivity.componentSize(a) == size_a);
+        }
+    }
+    connectivity.refresh();
+    CHECK(&connectivity.graph() == &g);
+}
+
+int main() {
+    check_remove_edge<graph::AdjacencyList<false, long long>>();
+    check_remove_edge<graph::AdjacencyList<true, long long>>();
+    check_remove_edge<graph::AdjacencyMatrix<false, long long>>();
+    check_remove_edge<graph::AdjacencyMatrix<true, long long>>();
+    for (unsigned seed = 0; seed < 20; ++seed)
+        check_connectivity(seed);
+
+    // remove, then insert, then query, within one refresh
+    Graph g;
+    for (long long v = 0; v < 5; ++v)
+        g.addVertex(v);
+    graph::IncrementalConnectivity<Graph> connectivity(g);
+    connectivity.setEdge(std::size_t(0), std::size_t(1), true);
+    connectivity.setEdge(std::size_t(1), std::size_t(2), true);
+    CHECK(connectivity.componentNumber() == 3);
+    connectivity.removeEdge(1, 2);
+    connectivity.setEdge(std::size_t(2), std::size_t(3), true);
+    connectivity.setEdge(std::size_t(3), std::size_t(0), true);
+    CHECK(connectivity.connected(2, 1));
+    CHECK(connectivity.componentNumber() == 2 && connectivity.componentSize(0) == 4);
+    connectivity.removeEdge(3, 0);
+    connectivity.removeEdge(0, 1);
+    CHECK(!connectivity.connected(0, 2) && connectivity.connected(2, 3));
+    CHECK(connectivity.componentNumber() == 4);
+    connectivity.setEdge(10ll, 11ll, true); // new vertices by info
+    CHECK(connectivity.componentNumber() == 5 && connectivity.connected(5, 6));
+    return graph_test::report();
+}
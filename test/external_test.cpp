@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "random_graph.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/external.hpp"
+
+namespace fs = std::filesystem;
+
+std::string temp_path(const std::string &name) {
+    return (fs::temp_directory_path() / ("graph_external_test_" + name + ".bin")).string();
+}
+
+// root and depth of every vertex, and whether every tree edge is an arc one level down
+struct Forest {
+    std::vector<std::size_t> root, depth;
+    bool tree_edges_valid = true;
+    std::size_t scans = 0; // of the edge file
+};
+
+template <typename G>
+Forest in_memory_forest(G &g) {
+    std::size_t n = graph::get_vertex_number(g);
+    Forest res{ std::vector<std::size_t>(n), std::vector<std::size_t>(n) };
+    graph::breadth_first_traverse(g, [&](auto &, auto from, std::size_t to) {
+        res.root[to] = from == -1 ? to : res.root[from];
+        res.depth[to] = from == -1 ? 0 : res.depth[from] + 1;
+    });
+    return res;
+}
+
+template <typename G>
+Forest external_forest(G &g, const graph::ExternalEdgeList &edges) {
+    std::size_t n = edges.vertexNumber();
+    Forest res{ std::vector<std::size_t>(n, n), std::vector<std::size_t>(n) };
+    std::size_t visits = 0;
+    res.scans = graph::external_breadth_first_traverse(edges, [&](auto &, auto from, std::size_t to) {
+        ++visits;
+        if (res.root[to] != n || (from != -1 && res.root[from] == n))
+            res.tree_edges_valid = false; // visited twice or parent not visited yet
+        if (from != -1 && !g.getEdge(std::size_t(from), to))
+            res.tree_edges_valid = false;
+        res.root[to] = from == -1 ? to : res.root[from];
+        res.depth[to] = from == -1 ? 0 : res.depth[from] + 1;
+    });
+    res.tree_edges_valid = res.tree_edges_valid && visits == n;
+    return res;
+}
+
+template <bool IsDirected>
+void check_against_memory(std::size_t n, std::size_t m, unsigned seed) {
+    auto g = graph_test::random_graph<graph::AdjacencyList<IsDirected, long long>>(n, m, seed);
+    auto path = temp_path(std::to_string(IsDirected) + "_" + std::to_string(seed));
+    std::size_t block_bytes = 256; // the memory cap: 16 arcs at a time
+    auto edges = graph::write_edge_list(g, path, block_bytes);
+    CHECK(edges.blockBytes() == block_bytes);
+    CHECK(fs::file_size(path) > 10 * block_bytes);
+
+    std::size_t arcs = 0;
+    for (std::size_t v = 0; v < n; ++v)
+        arcs += g.neighbors(v).size();
+    CHECK(edges.arcNumber() == arcs);
+
+    auto expected = in_memory_forest(g);
+    auto actual = external_forest(g, edges);
+    CHECK(actual.tree_edges_valid);
+    CHECK(actual.root == expected.root);
+    CHECK(actual.depth == expected.depth);
+    // one scan for the components, then one per level of the deepest tree, a directed
+    // graph may add levels for roots that a component hands over to
+    std::size_t levels = *std::max_element(expected.depth.begin(), expected.depth.end()) + 1;
+    if (IsDirected)
+        CHECK(actual.scans >= 1 + levels);
+    else
+        CHECK(actual.scans == 1 + levels);
+
+    // weak components, labelled by their smallest vertex
+    graph::AdjacencyList<false, long long> undirected;
+    for (std::size_t v = 0; v < n; ++v)
+        undirected.addVertex(static_cast<long long>(v));
+    for (std::size_t v = 0; v < n; ++v) {
+        for (auto a : g.neighbors(v))
+            undirected.setEdge(v, a.to, true);
+    }
+    CHECK(graph::external_connected_components(edges) == in_memory_forest(undirected).root);
+    fs::remove(path);
+}
+
+int main() {
+    for (unsigned seed = 0; seed < 3; ++seed) {
+        check_against_memory<false>(400, 300 + 200 * seed, seed);
+        check_against_memory<true>(400, 300 + 200 * seed, seed);
+    }
+
+    // many small components share every scan: 20000 disjoint pairs take three scans, one for
+    // the components, one reaching the partner of every root and one finding nothing left
+    auto path = temp_path("pairs");
+    graph::ExternalEdgeListWriter writer(path, 4096);
+    for (std::size_t v = 0; v < 40000; v += 2) {
+        writer.addArc(v, v + 1);
+        writer.addArc(v + 1, v);
+    }
+    auto pairs = writer.close(0, 4096);
+    std::size_t roots = 0, reached = 0;
+    auto scans = graph::external_breadth_first_traverse(pairs, [&](auto &, auto from, std::size_t to) {
+        if (from == -1)
+            ++roots, CHECK(to % 2 == 0);
+        else
+            ++reached, CHECK(std::size_t(from) + 1 == to);
+    });
+    CHECK(roots == 20000 && reached == 20000);
+    CHECK(scans == 3);
+    fs::remove(path);
+
+    // buffered arcs are written even without close
+    path = temp_path("unclosed");
+    {
+        graph::ExternalEdgeListWriter unclosed(path, 1 << 20);
+        unclosed.addArc(0, 1);
+        unclosed.addArc(2, 3);
+    }
+    CHECK(fs::file_size(path) == 4 * sizeof(std::uint64_t));
+    CHECK(graph::ExternalEdgeList(path, 4).arcNumber() == 2);
+    fs::remove(path);
+    CHECK_THROWS(graph::ExternalEdgeList(path, 4), std::runtime_error);
+
+    // assigning over a writer finishes its file first
+    auto first = temp_path("assigned_first"), second = temp_path("assigned_second");
+    {
+        graph::ExternalEdgeListWriter assigned(first, 1 << 20);
+        assigned.addArc(0, 1);
+        assigned.addArc(1, 2);
+        graph::ExternalEdgeListWriter other(second, 1 << 20);
+        other.addArc(5, 6);
+        assigned = std::move(other);
+        CHECK(fs::file_size(first) == 4 * sizeof(std::uint64_t));
+        assigned.addArc(6, 7);
+        auto edges = assigned.close();
+        CHECK(edges.filePath() == second && edges.arcNumber() == 2 && edges.vertexNumber() == 8);
+    }
+    CHECK(graph::ExternalEdgeList(first, 3).arcNumber() == 2);
+    fs::remove(first);
+    fs::remove(second);
+
+    return graph_test::report();
+}
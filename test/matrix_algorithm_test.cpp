@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+#include "../matrix/algorithm.hpp"
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+Matrix<double> random_lengths(std::size_t n, double density, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::uniform_int_distribution<int> length(1, 20);
+    std::vector<std::vector<double>> d(n, std::vector<double>(n, infinity));
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i][i] = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            if (i != j && coin(rng) < density)
+                d[i][j] = length(rng); // integral lengths keep the sums exact
+        }
+    }
+    return Matrix<double>(std::move(d));
+}
+
+std::vector<std::vector<double>> naive_shortest_paths(const Matrix<double> &m) {
+    auto d = m.raw();
+    std::size_t n = d.size();
+    for (std::size_t k = 0; k < n; ++k)
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                if (d[i][k] + d[k][j] < d[i][j])
+                    d[i][j] = d[i][k] + d[k][j];
+    return d;
+}
+
+Matrix<bool> random_relation(std::size_t n, double density, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::vector<std::vector<bool>> r(n, std::vector<bool>(n, false));
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            r[i][j] = coin(rng) < density;
+    return Matrix<bool>(std::move(r));
+}
+
+// reachability by non empty paths, Warshall over a copy
+std::vector<std::vector<bool>> naive_closure(const Matrix<bool> &m) {
+    auto r = m.raw();
+    std::size_t n = r.size();
+    for (std::size_t k = 0; k < n; ++k)
+        for (std::size_t i = 0; i < n; ++i)
+            if (r[i][k])
+                for (std::size_t j = 0; j < n; ++j)
+                    if (r[k][j])
+                        r[i][j] = true;
+    return r;
+}
+
+int main() {
+    // sizes around and between the block sizes and the 64 bit words
+    for (std::size_t n : { 0, 1, 2, 63, 64, 65, 70, 150 }) {
+        for (unsigned seed = 0; seed < 2; ++seed) {
+            auto lengths = random_lengths(n, seed == 0 ? 0.03 : 0.2, seed + static_cast<unsigned>(n));
+            auto expected = naive_shortest_paths(lengths);
+            for (std::size_t block : { 1, 7, 16, 64, 200 }) {
+                for (std::size_t threads : { 1, 4 })
+                    CHECK(floyd_warshall(lengths, threads, block).raw() == expected);
+            }
+            CHECK(floyd_warshall(lengths).raw() == expected);
+
+            auto relation = random_relation(n, seed == 0 ? 0.01 : 0.05, seed + static_cast<unsigned>(n));
+            auto closure = naive_closure(relation);
+            for (std::size_t threads : { 1, 4, 0 })
+                CHECK(transitive_closure(relation, threads).raw() == closure);
+        }
+    }
+
+    // a cycle reaches every vertex, itself included, a path never returns
+    std::size_t n = 130;
+    std::vector<std::vector<bool>> cycle(n, std::vector<bool>(n, false)), path = cycle;
+    for (std::size_t i = 0; i < n; ++i) {
+        cycle[i][(i + 1) % n] = true;
+        if (i + 1 < n)
+            path[i][i + 1] = true;
+    }
+    auto cycle_closure = transitive_closure(Matrix<bool>(cycle)).raw();
+    auto path_closure = transitive_closure(Matrix<bool>(path)).raw();
+    bool cycle_full = true, path_upper = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            cycle_full = cycle_full && cycle_closure[i][j];
+            path_upper = path_upper && path_closure[i][j] == (j > i);
+        }
+    }
+    CHECK(cycle_full);
+    CHECK(path_upper);
+
+    CHECK_THROWS(floyd_warshall(Matrix<double>(std::vector<std::vector<double>>(2, std::vector<double>(3, 0)))),
+                 std::invalid_argument);
+    CHECK_THROWS(floyd_warshall(random_lengths(3, 0.5, 1), 1, 0), std::invalid_argument);
+    CHECK_THROWS(transitive_closure(Matrix<bool>(std::vector<std::vector<bool>>(3, std::vector<bool>(2, false)))),
+                 std::invalid_argument);
+    return graph_test::report();
+}
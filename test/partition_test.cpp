@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+#include "random_graph.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/partition.hpp"
+
+using Arcs = std::vector<std::tuple<std::size_t, std::size_t, int>>;
+
+// a vertex info counting its comparisons, each vertex lookup by info compares
+struct Counted {
+    static inline std::size_t comparisons = 0;
+
+    friend bool operator==(const Counted &a, const Counted &b) {
+        ++comparisons;
+        return a.value == b.value;
+    }
+
+    long long value;
+};
+
+template <typename G>
+Arcs arcs_of(const G &g, const std::vector<std::size_t> &ids) {
+    Arcs res;
+    for (std::size_t v = 0; v < get_vertex_number(g); ++v) {
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+            auto adjacency_info = *beg;
+            res.emplace_back(ids[v], ids[adjacency_info.to], adjacency_info.edge_info);
+        }
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+template <typename G>
+void check_partition(G &&g, std::size_t k, graph::PartitionMethod method) {
+    std::size_t n = get_vertex_number(g);
+    auto res = graph::partition(g, k, method);
+    CHECK(res.parts == k && res.part_of.size() == n && res.subgraphs.size() == k);
+
+    std::vector<std::size_t> sizes(k, 0), identity(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        identity[v] = v;
+        CHECK(res.part_of[v] < k);
+        ++sizes[res.part_of[v]];
+    }
+    for (auto size : sizes)
+        CHECK(size <= std::max<std::size_t>((n + k - 1) / k, static_cast<std::size_t>(n * 1.05 / k + 1)));
+
+    auto all = arcs_of(g, identity);
+    std::size_t cut = 0;
+    for (auto &[from, to, e] : all)
+        cut += res.part_of[from] != res.part_of[to];
+    CHECK(res.edge_cut == cut);
+
+    for (std::size_t p = 0; p < k; ++p) {
+        auto &part = res.subgraphs[p];
+        CHECK(part.owned == sizes[p]);
+        CHECK(get_vertex_number(part.graph) == part.local_to_global.size());
+        for (std::size_t i = 0; i < part.local_to_global.size(); ++i) {
+            auto v = part.local_to_global[i];
+            CHECK((res.part_of[v] == p) == (i < part.owned));
+            CHECK(get_vertex(part.graph, i) == get_vertex(g, v));
+        }
+        // every arc with an end in the part, and nothing else
+        Arcs expected;
+        for (auto &arc : all) {
+            if (res.part_of[std::get<0>(arc)] == p || res.part_of[std::get<1>(arc)] == p)
+                expected.push_back(arc);
+        }
+        CHECK(arcs_of(part.graph, part.local_to_global) == expected);
+    }
+
+    auto old_to_new = graph::partition_permutation(res.part_of, k);
+    for (std::size_t v = 0; v < n; ++v) {
+        for (std::size_t u = 0; u < n; ++u) {
+            if (res.part_of[v] < res.part_of[u])
+                CHECK(old_to_new[v] < old_to_new[u]);
+        }
+    }
+}
+
+int main() {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        for (auto method : { graph::PartitionMethod::LinearDeterministicGreedy, graph::PartitionMethod::Fennel }) {
+            for (std::size_t k : { 1, 2, 5 }) {
+                check_partition(graph_test::random_graph<graph::AdjacencyList<true, long long, int>>(60, 150, seed, 0, 8), k, method);
+                check_partition(graph_test::random_graph<graph::AdjacencyList<false, long long, int>>(60, 150, seed, 0, 8), k, method);
+                check_partition(graph_test::random_graph<graph::AdjacencyMatrix<true, long long, int>>(40, 100, seed, 0, 8), k, method);
+                check_partition(graph_test::random_graph<graph::AdjacencyMatrix<false, long long, int>>(40, 100, seed, 0, 8), k, method);
+            }
+        }
+    }
+    graph::AdjacencyList<true, long long, int> empty(0);
+    CHECK(graph::partition(empty, 3).subgraphs.size() == 3);
+    CHECK_THROWS(graph::partition(empty, 0), std::invalid_argument);
+
+    // building the parts looks no vertex up, a lookup per added vertex made it quadratic in the part size
+    graph::AdjacencyList<true, Counted, int> path(0);
+    std::size_t n = 4000;
+    for (std::size_t v = 0; v < n; ++v)
+        path.addVertex(Counted{ static_cast<long long>(v) });
+    for (std::size_t v = 0; v + 1 < n; ++v)
+        path.setEdge(v, v + 1, 1);
+    Counted::comparisons = 0;
+    auto res = graph::partition(path, 2);
+    CHECK(res.subgraphs[0].owned + res.subgraphs[1].owned == n);
+    CHECK(Counted::comparisons == 0);
+    CHECK(res.subgraphs[0].graph.getVertex(0) == path.getVertex(res.subgraphs[0].local_to_global[0]));
+    return graph_test::report();
+}
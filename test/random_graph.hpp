@@ -0,0 +1,33 @@
+#ifndef GRAPH_TEST_RANDOM_GRAPH_HPP_INCLUDED
+#define GRAPH_TEST_RANDOM_GRAPH_HPP_INCLUDED
+
+#include <cstddef>
+#include <random>
+
+// Random graphs shared by the test executables
+namespace graph_test {
+
+// n vertices, vertex v has info 7 v + 100 so that infos and ids differ, and m setEdge
+// calls between random ends with edge infos drawn from [min_weight, max_weight];
+// a weight equal to the default edge info removes the edge instead
+template <typename G>
+G random_graph(std::size_t n, std::size_t m, unsigned seed, int min_weight = 1, int max_weight = 1) {
+    using edge_info_type = typename G::edge_info_type;
+    std::mt19937 rng(seed);
+    G g(edge_info_type{});
+    for (std::size_t v = 0; v < n; ++v)
+        g.addVertex(static_cast<long long>(v) * 7 + 100);
+    for (std::size_t i = 0; i < m; ++i) {
+        std::size_t from = rng() % n;
+        std::size_t to = rng() % n;
+        int weight = min_weight;
+        if (max_weight > min_weight)
+            weight += static_cast<int>(rng() % static_cast<unsigned>(max_weight - min_weight + 1));
+        g.setEdge(from, to, static_cast<edge_info_type>(weight));
+    }
+    return g;
+}
+
+} // ! namespace graph_test
+
+#endif // GRAPH_TEST_RANDOM_GRAPH_HPP_INCLUDED
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "check.hpp"
+#include "random_graph.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/reorder.hpp"
+
+using Arcs = std::vector<std::tuple<std::size_t, std::size_t, int>>;
+
+// the arcs of g with their ends renamed by mapping
+template <typename G>
+Arcs arcs_of(G &g, const std::vector<std::size_t> &mapping) {
+    Arcs res;
+    for (std::size_t v = 0; v < get_vertex_number(g); ++v) {
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+            auto adjacency_info = *beg;
+            res.emplace_back(mapping[v], mapping[adjacency_info.to], adjacency_info.edge_info);
+        }
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+template <typename G>
+bool sorted_neighbors(G &g) {
+    for (std::size_t v = 0; v < get_vertex_number(g); ++v) {
+        std::size_t previous = 0;
+        bool first = true;
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+            auto to = (*beg).to;
+            if (!first && to <= previous)
+                return false;
+            previous = to, first = false;
+        }
+    }
+    return true;
+}
+
+template <typename G>
+void check_reorder(G g, graph::ReorderMethod method) {
+    std::size_t n = get_vertex_number(g);
+    std::vector<std::size_t> identity(n);
+    for (std::size_t v = 0; v < n; ++v)
+        identity[v] = v;
+    auto before = arcs_of(g, identity);
+    std::vector<long long> infos;
+    for (std::size_t v = 0; v < n; ++v)
+        infos.push_back(get_vertex(g, v));
+
+    auto old_to_new = graph::reorder(g, method);
+    CHECK(old_to_new.size() == n);
+    std::vector<bool> seen(n, false);
+    for (auto v : old_to_new) {
+        CHECK(v < n && !seen[v]);
+        if (v < n)
+            seen[v] = true;
+    }
+    // renaming the old arcs gives exactly the new ones, and the vertex infos moved along
+    CHECK(arcs_of(g, identity) == [&] {
+        Arcs res;
+        for (auto &[from, to, e] : before)
+            res.emplace_back(old_to_new[from], old_to_new[to], e);
+        std::sort(res.begin(), res.end());
+        return res;
+    }());
+    for (std::size_t v = 0; v < n; ++v) {
+        CHECK(get_vertex(g, old_to_new[v]) == infos[v]);
+        CHECK(get_vertex_index(g, infos[v]) == static_cast<long long>(old_to_new[v]));
+    }
+    CHECK(sorted_neighbors(g));
+    if (method == graph::ReorderMethod::DegreeSort) {
+        auto degrees = graph::detail::out_degrees(g);
+        CHECK(std::is_sorted(degrees.rbegin(), degrees.rend()));
+    }
+}
+
+// largest |from - to| over the edges
+template <typename G>
+std::size_t bandwidth(G &g) {
+    std::size_t res = 0;
+    for (std::size_t v = 0; v < get_vertex_number(g); ++v) {
+        for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg) {
+            auto to = (*beg).to;
+            res = std::max(res, to > v ? to - v : v - to);
+        }
+    }
+    return res;
+}
+
+int main() {
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        for (auto method : { graph::ReorderMethod::ReverseCuthillMcKee, graph::ReorderMethod::DegreeSort }) {
+            check_reorder(graph_test::random_graph<graph::AdjacencyList<false, long long, int>>(50, 80, seed, 1, 6), method);
+            check_reorder(graph_test::random_graph<graph::AdjacencyList<true, long long, int>>(50, 120, seed, 1, 6), method);
+            check_reorder(graph_test::random_graph<graph::AdjacencyMatrix<false, long long, int>>(30, 50, seed, 1, 6), method);
+            check_reorder(graph_test::random_graph<graph::AdjacencyMatrix<true, long long, int>>(30, 70, seed, 1, 6), method);
+        }
+    }
+    check_reorder(graph::AdjacencyList<false, long long, int>(0), graph::ReorderMethod::ReverseCuthillMcKee);
+
+    // a shuffled path gets back its bandwidth of 1
+    std::size_t n = 200;
+    std::vector<std::size_t> shuffled(n);
+    for (std::size_t v = 0; v < n; ++v)
+        shuffled[v] = v;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+    graph::AdjacencyList<false, long long> path;
+    for (std::size_t v = 0; v < n; ++v)
+        path.addVertex(static_cast<long long>(v));
+    for (std::size_t v = 0; v + 1 < n; ++v)
+        path.setEdge(shuffled[v], shuffled[v + 1], true);
+    CHECK(bandwidth(path) > 1);
+    graph::reorder(path);
+    CHECK(bandwidth(path) == 1);
+
+    CHECK_THROWS(path.permuteVertices(std::vector<std::size_t>(n, 0)), std::invalid_argument);
+    CHECK_THROWS(path.permuteVertices(std::vector<std::size_t>(n - 1, 0)), std::invalid_argument);
+    graph::AdjacencyMatrix<false, long long> matrix;
+    matrix.addVertex(1);
+    matrix.addVertex(2);
+    CHECK_THROWS(matrix.permuteVertices({ 1, 1 }), std::invalid_argument);
+    return graph_test::report();
+}
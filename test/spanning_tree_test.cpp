@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "check.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/spanning_tree.hpp"
+
+using Edges = std::vector<graph::Edge<std::size_t, int>>;
+
+// components clusters of vertices with random edges inside, none between them,
+// plus a few isolated vertices; small weight ranges make ties common
+template <typename G>
+G random_forest_graph(std::size_t clusters, std::size_t size, std::size_t m, int max_weight, unsigned seed) {
+    std::mt19937 rng(seed);
+    G g(0);
+    std::size_t n = clusters * size + 3;
+    for (std::size_t v = 0; v < n; ++v)
+        g.addVertex(static_cast<long long>(v) * 5);
+    for (std::size_t i = 0; i < m; ++i) {
+        std::size_t c = rng() % clusters;
+        std::size_t a = c * size + rng() % size, b = c * size + rng() % size;
+        if (a != b)
+            g.setEdge(a, b, static_cast<int>(rng() % max_weight) + 1);
+    }
+    return g;
+}
+
+long long weight_of(const Edges &forest) {
+    long long total = 0;
+    for (auto &edge : forest)
+        total += std::get<2>(edge);
+    return total;
+}
+
+// Prim from every unreached vertex, quadratic
+template <typename G>
+long long naive_forest_weight(G &g, std::size_t &trees) {
+    std::size_t n = get_vertex_number(g);
+    constexpr long long none = std::numeric_limits<long long>::max();
+    std::vector<bool> in_tree(n, false);
+    std::vector<long long> best(n, none);
+    long long total = 0;
+    trees = 0;
+    for (std::size_t root = 0; root < n; ++root) {
+        if (in_tree[root])
+            continue;
+        ++trees;
+        best[root] = 0;
+        while (true) {
+            std::size_t v = n;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (!in_tree[u] && best[u] != none && (v == n || best[u] < best[v]))
+                    v = u;
+            }
+            if (v == n)
+                break;
+            in_tree[v] = true;
+            total += best[v];
+            for (std::size_t u = 0; u < n; ++u) {
+                int e = g.getEdge(v, u);
+                if (e != 0 && !in_tree[u])
+                    best[u] = std::min<long long>(best[u], e);
+            }
+        }
+    }
+    return total;
+}
+
+// a forest of the graph: real edges with from < to and no cycle, with one tree per component
+template <typename G>
+bool valid_forest(G &g, const Edges &forest, std::size_t trees) {
+    std::size_t n = get_vertex_number(g);
+    graph::detail::UnionFind sets(n);
+    for (auto &[from, to, e] : forest) {
+        if (from >= to || to >= n || g.getEdge(from, to) != e || !sets.unite(from, to))
+            return false;
+    }
+    return forest.size() + trees == n;
+}
+
+Edges sorted(Edges edges) {
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+template <typename G>
+void check_forest(G g) {
+    std::size_t trees = 0;
+    auto expected = naive_forest_weight(g, trees);
+    for (std::size_t threads : { 1, 4 }) {
+        auto kruskal = graph::minimum_spanning_forest(g, threads);
+        auto boruvka = graph::minimum_spanning_forest_boruvka(g, threads);
+        CHECK(weight_of(kruskal) == expected);
+        CHECK(weight_of(boruvka) == expected);
+        CHECK(valid_forest(g, kruskal, trees));
+        CHECK(valid_forest(g, boruvka, trees));
+        // ties are broken by the endpoints, so the forest is unique
+        CHECK(sorted(kruskal) == sorted(boruvka));
+
+        auto forest = graph::minimum_spanning_forest_graph(g, threads);
+        CHECK(get_vertex_number(forest) == get_vertex_number(g));
+        Edges edges;
+        for (std::size_t v = 0; v < get_vertex_number(forest); ++v) {
+            CHECK(get_vertex(forest, v) == get_vertex(g, v));
+            for (auto beg = forest.adjacencyVertexBegin(v), end = forest.adjacencyVertexEnd(v); beg != end; ++beg) {
+                auto adjacency_info = *beg;
+                if (v < adjacency_info.to)
+                    edges.emplace_back(v, adjacency_info.to, adjacency_info.edge_info);
+            }
+        }
+        CHECK(sorted(edges) == sorted(kruskal));
+    }
+}
+
+int main() {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        for (int max_weight : { 1, 3, 1000 }) {
+            check_forest(random_forest_graph<graph::AdjacencyList<false, long long, int>>(4, 15, 80, max_weight, seed));
+            check_forest(random_forest_graph<graph::AdjacencyMatrix<false, long long, int>>(3, 12, 50, max_weight, seed));
+        }
+    }
+    // enough edges for the parallel sort to split them
+    check_forest(random_forest_graph<graph::AdjacencyList<false, long long, int>>(2, 200, 12000, 50, 9));
+    check_forest(graph::AdjacencyList<false, long long, int>(0));
+    check_forest(graph::AdjacencyMatrix<false, long long, int>(0));
+    return graph_test::report();
+}
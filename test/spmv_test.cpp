@@ -0,0 +1,203 @@
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+#include "random_graph.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/detail/parallel.hpp"
+#include "../graph/pagerank.hpp"
+#include "../graph/spmv.hpp"
+
+using Dense = std::vector<std::vector<double>>;
+
+template <typename G>
+Dense dense_of(G &g) {
+    std::size_t n = get_vertex_number(g);
+    Dense a(n, std::vector<double>(n, 0));
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            a[i][j] = g.getEdge(i, j);
+    return a;
+}
+
+bool close(const std::vector<double> &a, const std::vector<double> &b, double tolerance = 1e-9) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::fabs(a[i] - b[i]) > tolerance)
+            return false;
+    }
+    return true;
+}
+
+// every entry of rows() is the dense matrix, or its transpose
+bool same_matrix(const graph::CompressedSparseRows<double> &a, const Dense &dense, bool transpose) {
+    std::size_t n = dense.size();
+    if (a.rows() != n || a.offsets[0] != 0 || a.values.size() != a.columns.size())
+        return false;
+    Dense seen(n, std::vector<double>(n, 0));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = a.offsets[i]; k < a.offsets[i + 1]; ++k) {
+            if (a.values[k] == 0 || seen[i][a.columns[k]] != 0)
+                return false;
+            seen[i][a.columns[k]] = a.values[k];
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            if (seen[i][j] != (transpose ? dense[j][i] : dense[i][j]))
+                return false;
+    return true;
+}
+
+template <typename G>
+void check_spmv(G g, unsigned seed) {
+    std::size_t n = get_vertex_number(g);
+    auto dense = dense_of(g);
+    auto a = graph::to_compressed_sparse_rows<double>(g);
+    auto at = graph::to_compressed_sparse_rows<double>(g, true);
+    CHECK(same_matrix(a, dense, false));
+    CHECK(same_matrix(at, dense, true));
+    auto ones = graph::to_compressed_sparse_rows<double>(g, false, [](int) { return 1; });
+    CHECK(ones.nonZeros() == a.nonZeros());
+    for (auto value : ones.values)
+        CHECK(value == 1);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-1, 1);
+    std::vector<double> x(n);
+    for (auto &value : x)
+        value = uniform(rng);
+    std::vector<double> ax(n, 0), atx(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            ax[i] += dense[i][j] * x[j];
+            atx[j] += dense[i][j] * x[i];
+        }
+    }
+    for (std::size_t threads : { 1, 3, 0 }) {
+        std::vector<double> y;
+        graph::spmv_pull(a, x, y, threads);
+        CHECK(close(y, ax));
+        graph::spmv_pull(at, x, y, threads);
+        CHECK(close(y, atx));
+        // push over A gives A^T x, the same as pull over the transpose
+        graph::spmv_push(a, x, y, threads);
+        CHECK(close(y, atx));
+        std::vector<std::vector<double>> scratch;
+        graph::spmv_push(at, x, y, scratch, threads);
+        graph::spmv_push(at, x, y, scratch, threads); // reused scratch starts from zero again
+        CHECK(close(y, ax));
+    }
+    std::vector<double> y, short_x(n == 0 ? 0 : n - 1);
+    if (n != 0) {
+        CHECK_THROWS(graph::spmv_pull(a, short_x, y), std::invalid_argument);
+        CHECK_THROWS(graph::spmv_push(a, short_x, y), std::invalid_argument);
+    }
+}
+
+// dense power iteration of the same model, dangling vertices teleport
+std::vector<double> naive_pagerank(const Dense &dense, std::vector<double> teleport, double damping, std::size_t iterations) {
+    std::size_t n = dense.size();
+    std::vector<double> out_degree(n, 0), ranks = teleport;
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            out_degree[i] += dense[i][j] != 0;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        double dangling = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            dangling += out_degree[i] == 0 ? ranks[i] : 0;
+        std::vector<double> next(n, 0);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                if (dense[i][j] != 0)
+                    next[j] += damping * ranks[i] / out_degree[i];
+        for (std::size_t j = 0; j < n; ++j)
+            next[j] += (1 - damping + damping * dangling) * teleport[j];
+        ranks = next;
+    }
+    return ranks;
+}
+
+double sum(const std::vector<double> &values) {
+    double res = 0;
+    for (auto value : values)
+        res += value;
+    return res;
+}
+
+void check_pagerank(unsigned seed) {
+    auto g = graph_test::random_graph<graph::AdjacencyList<true, long long, int>>(300, 600, seed, 1, 7); // with dangling vertices
+    auto dense = dense_of(g);
+    std::size_t n = dense.size();
+    graph::PageRankOptions options;
+    options.tolerance = 1e-12;
+    options.max_iterations = 500;
+    options.threads = seed % 3;
+    auto uniform = graph::pagerank(g, options);
+    CHECK(std::fabs(sum(uniform.ranks) - 1) < 1e-9);
+    CHECK(uniform.residual < 1e-12 && uniform.iterations < 500);
+    CHECK(close(uniform.ranks, naive_pagerank(dense, std::vector<double>(n, 1.0 / n), 0.85, uniform.iterations), 1e-9));
+
+    options.personalization.assign(n, 0);
+    options.personalization[seed % n] = 3;
+    options.personalization[(seed * 7 + 1) % n] += 1;
+    auto personalized = graph::pagerank(g, options);
+    CHECK(std::fabs(sum(personalized.ranks) - 1) < 1e-9);
+    std::vector<double> teleport(n);
+    for (std::size_t i = 0; i < n; ++i)
+        teleport[i] = options.personalization[i] / sum(options.personalization);
+    CHECK(close(personalized.ranks, naive_pagerank(dense, teleport, 0.85, personalized.iterations), 1e-9));
+
+    options.personalization.assign(n - 1, 1);
+    CHECK_THROWS(graph::pagerank(g, options), std::invalid_argument);
+    options.personalization.assign(n, 0);
+    CHECK_THROWS(graph::pagerank(g, options), std::invalid_argument);
+}
+
+void check_parallel_for() {
+    for (std::size_t n : { 0, 1, 1023, 1024, 100000 }) {
+        for (std::size_t threads : { 1, 2, 7, 0 }) {
+            std::vector<std::atomic<int>> hits(n);
+            graph::detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                    ++hits[i];
+            });
+            bool once = true;
+            for (auto &hit : hits)
+                once = once && hit == 1;
+            CHECK(once);
+        }
+    }
+    // loops nested in loops run on the same pool
+    std::atomic<std::size_t> total{0};
+    graph::detail::parallel_for(64, 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            graph::detail::parallel_for(5000, 4, [&](std::size_t b, std::size_t e) { total += e - b; }, 100);
+        }
+    }, 1);
+    CHECK(total == 64 * 5000);
+    CHECK_THROWS(graph::detail::parallel_for(10000, 4, [](std::size_t begin, std::size_t) {
+        if (begin == 5 * 1024)
+            throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+}
+
+int main() {
+    check_parallel_for();
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        check_spmv(graph_test::random_graph<graph::AdjacencyList<true, long long, int>>(80, 300, seed, 1, 7), seed);
+        check_spmv(graph_test::random_graph<graph::AdjacencyList<false, long long, int>>(80, 300, seed, 1, 7), seed);
+        check_spmv(graph_test::random_graph<graph::AdjacencyMatrix<true, long long, int>>(50, 200, seed, 1, 7), seed);
+        check_spmv(graph_test::random_graph<graph::AdjacencyList<true, long long, int>>(1500, 6000, seed, 1, 7), seed);
+        check_pagerank(seed);
+    }
+    check_spmv(graph::AdjacencyList<true, long long, int>(0), 0);
+    graph::AdjacencyList<true, long long> empty;
+    CHECK(graph::pagerank(empty).ranks.empty());
+    return graph_test::report();
+}
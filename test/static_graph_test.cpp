@@ -0,0 +1,140 @@
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/static_graph.hpp"
+
+// patterns built and traversed in constant expressions
+constexpr graph::StaticGraph<6, false> make_pattern() {
+    graph::StaticGraph<6, false> g;
+    g.setEdge(0, 1, true);
+    g.setEdge(1, 2, true);
+    g.setEdge(0, 3, true);
+    g.setEdge(4, 5, true); // second component
+    return g;
+}
+
+constexpr graph::StaticGraph<6, false> pattern = make_pattern();
+
+// std::array comparison is not constexpr before C++20
+template <typename T, std::size_t N>
+constexpr bool same(const std::array<T, N> &a, const std::array<T, N> &b) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+constexpr std::array<std::size_t, 6> bfs_order() {
+    std::array<std::size_t, 6> order{};
+    std::size_t k = 0;
+    graph::breadth_first_traverse(pattern, [&](auto &, auto, std::size_t to) { order[k++] = to; });
+    return order;
+}
+
+constexpr std::array<long long, 6> dfs_parents() {
+    std::array<long long, 6> parent{};
+    graph::depth_first_traverse(pattern, [&](auto &, long long from, long long to) { parent[to] = from; });
+    return parent;
+}
+
+constexpr std::array<std::size_t, 6> non_recursive_order() {
+    std::array<std::size_t, 6> order{};
+    std::size_t k = 0;
+    graph::depth_first_traverse_non_recursive(pattern, [&](auto &, std::size_t v) { order[k++] = v; });
+    return order;
+}
+
+constexpr std::size_t within(std::size_t source, std::size_t max_depth) {
+    std::size_t count = 0;
+    graph::breadth_first_traverse_from(pattern, source, max_depth, [&](auto &, auto, std::size_t, std::size_t) { ++count; });
+    return count;
+}
+
+// a mutable graph must reach the overloads above as well, the generic ones are not constexpr
+constexpr std::size_t mutable_reach() {
+    graph::StaticGraph<5, true> g;
+    g.setEdge(0, 2, true);
+    g.setEdge(2, 4, true);
+    std::size_t reached = 0;
+    graph::breadth_first_traverse_from(g, 0, 4, [&](auto &, auto, std::size_t to, std::size_t) { reached |= std::size_t(1) << to; });
+    graph::depth_first_traverse(g, [&](auto &, long long, long long) { });
+    graph::depth_first_traverse_non_recursive(g, [&](auto &, std::size_t) { });
+    graph::breadth_first_traverse(g, [&](auto &, auto, std::size_t) { });
+    return reached;
+}
+
+constexpr std::size_t weighted_sum() {
+    graph::StaticGraph<4, true, int> g(-1);
+    g.setEdge(0, 1, 5);
+    g.setEdge(1, 2, 7);
+    g.setEdge(1, 2, -1); // removes it again
+    g.setEdge(3, 0, 0);
+    std::size_t sum = 0;
+    for (auto adjacency_info : g.neighbors(0))
+        sum += adjacency_info.to * 100 + static_cast<std::size_t>(adjacency_info.edge_info);
+    return sum + g.degree(1) * 1000 + static_cast<std::size_t>(g.getEdge(3, 0)) * 10000;
+}
+
+static_assert(same(bfs_order(), { 0, 1, 3, 2, 4, 5 }));
+static_assert(same(dfs_parents(), { -1, 0, 1, 0, -1, 4 }));
+static_assert(same(non_recursive_order(), { 0, 3, 1, 2, 4, 5 }));
+static_assert(within(1, 0) == 1 && within(1, 1) == 3 && within(1, 5) == 4 && within(5, 5) == 2);
+static_assert(pattern.degree(0) == 2 && pattern.getEdge(3, 0) && !pattern.getEdge(2, 3));
+static_assert(weighted_sum() == 105);
+static_assert(mutable_reach() == 0b10101);
+static_assert(std::is_same_v<std::iterator_traits<graph::StaticGraph<8, false>::iterator>::iterator_category,
+                             std::input_iterator_tag>);
+
+template <bool IsDirected>
+void check_against_list(unsigned seed) {
+    std::mt19937 rng(seed);
+    graph::StaticGraph<64, IsDirected, int> fixed(0);
+    graph::AdjacencyList<IsDirected, long long, int> list(0);
+    for (long long v = 0; v < 64; ++v)
+        list.addVertex(v * 5);
+    for (std::size_t i = 0; i < 120; ++i) {
+        std::size_t a = rng() % 64, b = rng() % 64;
+        int w = static_cast<int>(rng() % 4);
+        fixed.setEdge(a, b, w);
+        list.setEdge(a, b, w);
+    }
+    std::vector<long long> a, b;
+    auto record = [](std::vector<long long> &out) {
+        return [&out](auto &, auto from, auto to) { out.push_back(from); out.push_back(static_cast<long long>(to)); };
+    };
+    graph::breadth_first_traverse(fixed, record(a));
+    graph::breadth_first_traverse(list, record(b));
+    CHECK(a == b);
+    a.clear(), b.clear();
+    graph::depth_first_traverse(fixed, record(a));
+    graph::depth_first_traverse(list, record(b));
+    CHECK(a == b);
+    a.clear(), b.clear();
+    const auto &constant = fixed;
+    graph::depth_first_traverse_non_recursive(constant, [&](auto &, std::size_t v) { a.push_back(static_cast<long long>(v)); });
+    graph::depth_first_traverse_non_recursive(list, [&](auto &, std::size_t v) { b.push_back(static_cast<long long>(v)); });
+    CHECK(a == b);
+    for (std::size_t v = 0; v < 64; ++v) {
+        for (std::size_t u = 0; u < 64; ++u)
+            CHECK(fixed.getEdge(v, u) == list.getEdge(v, u));
+    }
+}
+
+int main() {
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        check_against_list<false>(seed);
+        check_against_list<true>(seed);
+    }
+    graph::StaticGraph<8, true> g;
+    CHECK_THROWS(g.setEdge(0, 8, true), std::out_of_range);
+    CHECK_THROWS(g.addVertex(8), std::out_of_range);
+    CHECK(g.addVertex(7) == 7 && g.indexOfVertex(9) == -1);
+    CHECK_THROWS(graph::breadth_first_traverse_from(g, 8, 1, [](auto &, auto, auto, auto) { }), std::out_of_range);
+    return graph_test::report();
+}
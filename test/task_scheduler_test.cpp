@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/task_scheduler.hpp"
+#include "../graph/thread_pool.hpp"
+
+using Graph = graph::AdjacencyList<true, long long>;
+
+// edges only go from lower to higher ids, so the graph is acyclic
+Graph random_dag(std::size_t n, std::size_t m, unsigned seed) {
+    std::mt19937 rng(seed);
+    Graph g;
+    for (std::size_t v = 0; v < n; ++v)
+        g.addVertex(static_cast<long long>(v) + 1000);
+    for (std::size_t i = 0; i < m; ++i) {
+        std::size_t a = rng() % n, b = rng() % n;
+        if (a != b)
+            g.setEdge(std::min(a, b), std::max(a, b), true);
+    }
+    return g;
+}
+
+Graph chain(std::size_t n) {
+    Graph g;
+    for (std::size_t v = 0; v < n; ++v)
+        g.addVertex(static_cast<long long>(v));
+    for (std::size_t v = 0; v + 1 < n; ++v)
+        g.setEdge(v, v + 1, true);
+    return g;
+}
+
+std::vector<std::vector<std::size_t>> predecessors_of(Graph &g) {
+    std::vector<std::vector<std::size_t>> res(get_vertex_number(g));
+    for (std::size_t v = 0; v < res.size(); ++v) {
+        for (auto adjacency_info : g.neighbors(v))
+            res[adjacency_info.to].push_back(v);
+    }
+    return res;
+}
+
+// vertices on the longest chain, the ids are a topological order
+std::size_t naive_critical_path(Graph &g) {
+    std::size_t n = get_vertex_number(g), res = 0;
+    std::vector<std::size_t> depth(n, 1);
+    for (std::size_t v = 0; v < n; ++v) {
+        res = std::max(res, depth[v]);
+        for (auto adjacency_info : g.neighbors(v))
+            depth[adjacency_info.to] = std::max(depth[adjacency_info.to], depth[v] + 1);
+    }
+    return res;
+}
+
+void check_dependencies(graph::ThreadPool &pool, unsigned seed) {
+    auto g = random_dag(300, 900, seed);
+    auto predecessors = predecessors_of(g);
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[300]);
+    for (std::size_t v = 0; v < 300; ++v)
+        done[v] = false;
+    std::atomic<std::size_t> early{0}, calls{0};
+    auto result = graph::run_task_graph(g, [&](Graph &, std::size_t v) {
+        for (auto u : predecessors[v])
+            early += !done[u];
+        ++calls;
+        done[v] = true;
+    }, pool);
+    CHECK(early == 0);
+    CHECK(calls == 300);
+    CHECK(result.completed == 300 && result.skipped == 0);
+    CHECK(result.critical_path_length == naive_critical_path(g));
+    CHECK(result.critical_path_seconds >= 0);
+}
+
+int main() {
+    graph::ThreadPool pool(4), single(1);
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        check_dependencies(pool, seed);
+        check_dependencies(single, seed);
+    }
+
+    auto line = chain(10);
+    auto result = graph::run_task_graph(line, [](Graph &, std::size_t) { }, pool);
+    CHECK(result.completed == 10 && result.critical_path_length == 10);
+    Graph empty;
+    result = graph::run_task_graph(empty, [](Graph &, std::size_t) { }, pool);
+    CHECK(result.completed == 0 && result.skipped == 0 && result.critical_path_length == 0);
+    result = graph::run_task_graph(line, [](Graph &, std::size_t) { }); // with its own pool
+    CHECK(result.completed == 10);
+
+    // a cycle is rejected before anything runs
+    auto cyclic = chain(5);
+    cyclic.setEdge(std::size_t(4), std::size_t(1), true);
+    std::atomic<std::size_t> calls{0};
+    CHECK_THROWS(graph::run_task_graph(cyclic, [&](Graph &, std::size_t) { ++calls; }, pool), std::invalid_argument);
+    CHECK(calls == 0);
+
+    // cancelling skips every task not started yet
+    graph::CancellationToken token;
+    result = graph::run_task_graph(line, [&](Graph &, std::size_t v) {
+        if (v == 3)
+            token.cancel();
+    }, pool, &token);
+    CHECK(result.completed == 4 && result.skipped == 6);
+    result = graph::run_task_graph(line, [](Graph &, std::size_t) { }, pool, &token);
+    CHECK(result.completed == 0 && result.skipped == 10);
+
+    // the first exception is rethrown and the tasks after it do not run
+    calls = 0;
+    CHECK_THROWS(graph::run_task_graph(line, [&](Graph &, std::size_t v) {
+        ++calls;
+        if (v == 4)
+            throw std::runtime_error("task failed");
+    }, pool), std::runtime_error);
+    CHECK(calls == 5);
+    result = graph::run_task_graph(line, [](Graph &, std::size_t) { }, pool); // the pool is still usable
+    CHECK(result.completed == 10);
+
+    // task graphs started from tasks of the same pool wait without blocking it
+    for (auto *p : { &pool, &single }) {
+        auto outer = random_dag(12, 20, 3);
+        std::atomic<std::size_t> inner_completed{0};
+        result = graph::run_task_graph(outer, [&](Graph &, std::size_t v) {
+            auto inner = random_dag(40, 80, static_cast<unsigned>(v));
+            inner_completed += graph::run_task_graph(inner, [](Graph &, std::size_t) { }, *p).completed;
+        }, *p);
+        CHECK(result.completed == 12);
+        CHECK(inner_completed == 12 * 40);
+    }
+    return graph_test::report();
+}
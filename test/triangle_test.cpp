@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "check.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/compressed_graph.hpp"
+#include "../graph/static_graph.hpp"
+#include "../graph/triangle.hpp"
+
+using BoolMatrix = std::vector<std::vector<bool>>;
+
+// random symmetric adjacency, with self loops, skewed so that some degrees are large
+BoolMatrix random_matrix(std::size_t n, double density, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coin(0, 1);
+    BoolMatrix a(n, std::vector<bool>(n, false));
+    for (std::size_t v = 0; v < n; ++v) {
+        for (std::size_t u = v; u < n; ++u) {
+            double p = (v < 3 || u < 3) ? 0.8 : density;
+            if (coin(rng) < p)
+                a[v][u] = a[u][v] = true;
+        }
+    }
+    return a;
+}
+
+std::size_t naive_triangles(const BoolMatrix &a) {
+    std::size_t n = a.size(), count = 0;
+    for (std::size_t x = 0; x < n; ++x)
+        for (std::size_t y = x + 1; y < n; ++y)
+            for (std::size_t z = y + 1; z < n; ++z)
+                count += a[x][y] && a[y][z] && a[x][z];
+    return count;
+}
+
+std::vector<double> naive_clustering(const BoolMatrix &a) {
+    std::size_t n = a.size();
+    std::vector<double> res(n, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        std::vector<std::size_t> around;
+        for (std::size_t u = 0; u < n; ++u) {
+            if (u != v && a[v][u])
+                around.push_back(u);
+        }
+        if (around.size() < 2)
+            continue;
+        std::size_t links = 0;
+        for (std::size_t i = 0; i < around.size(); ++i)
+            for (std::size_t j = i + 1; j < around.size(); ++j)
+                links += a[around[i]][around[j]];
+        res[v] = 2.0 * links / (static_cast<double>(around.size()) * (around.size() - 1));
+    }
+    return res;
+}
+
+bool close(const std::vector<double> &a, const std::vector<double> &b) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::abs(a[i] - b[i]) > 1e-12)
+            return false;
+    }
+    return true;
+}
+
+template <typename G>
+void fill(G &g, const BoolMatrix &a) {
+    for (std::size_t v = 0; v < a.size(); ++v)
+        g.addVertex(static_cast<long long>(v) * 3);
+    for (std::size_t v = 0; v < a.size(); ++v)
+        for (std::size_t u = v; u < a.size(); ++u)
+            if (a[v][u])
+                g.setEdge(v, u, true);
+}
+
+void check_intersect(unsigned seed) {
+    std::mt19937 rng(seed);
+    for (std::size_t na : { 0, 1, 5, 40 }) {
+        for (std::size_t nb : { 0, 1, 7, 300, 5000 }) {
+            std::vector<std::size_t> a, b;
+            for (std::size_t i = 0; i < na; ++i)
+                a.push_back(rng() % 6000);
+            for (std::size_t i = 0; i < nb; ++i)
+                b.push_back(rng() % 6000);
+            for (auto *x : { &a, &b }) {
+                std::sort(x->begin(), x->end());
+                x->erase(std::unique(x->begin(), x->end()), x->end());
+            }
+            std::vector<std::size_t> common;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+            CHECK(graph::detail::intersect_count(a.data(), a.size(), b.data(), b.size()) == common.size());
+            CHECK(graph::detail::intersect_count(b.data(), b.size(), a.data(), a.size()) == common.size());
+            for (std::size_t value : { std::size_t(0), std::size_t(2999), std::size_t(6000), a.empty() ? 0 : a.back() }) {
+                auto expected = static_cast<std::size_t>(std::lower_bound(b.begin(), b.end(), value) - b.begin());
+                CHECK(graph::detail::gallop(b.data(), b.size(), value) == expected);
+            }
+        }
+    }
+}
+
+int main() {
+    check_intersect(1);
+    check_intersect(2);
+    for (unsigned seed = 0; seed < 6; ++seed) {
+        for (std::size_t n : { 0, 1, 2, 17, 64 }) {
+            auto a = random_matrix(n, 0.05 + 0.1 * seed, seed);
+            auto triangles = naive_triangles(a);
+            auto clustering = naive_clustering(a);
+
+            graph::AdjacencyList<false, long long> list;
+            fill(list, a);
+            CHECK(graph::triangle_count(list) == triangles);
+            CHECK(graph::triangle_count(list, 4) == triangles);
+            CHECK(close(graph::local_clustering_coefficient(list), clustering));
+            CHECK(close(graph::local_clustering_coefficient(list, 4), clustering));
+
+            graph::AdjacencyMatrix<false, long long> matrix;
+            fill(matrix, a);
+            CHECK(graph::triangle_count(matrix) == triangles);
+            CHECK(close(graph::local_clustering_coefficient(matrix), clustering));
+
+            graph::CompressedGraph<false, long long> compressed(list);
+            CHECK(graph::triangle_count(compressed) == triangles);
+            CHECK(close(graph::local_clustering_coefficient(compressed), clustering));
+
+            if (n == 64) {
+                graph::StaticGraph<64, false> fixed;
+                for (std::size_t v = 0; v < n; ++v)
+                    for (std::size_t u = 0; u < n; ++u)
+                        fixed.setEdge(v, u, a[v][u]);
+                CHECK(graph::triangle_count(fixed) == triangles);
+                CHECK(close(graph::local_clustering_coefficient(fixed), clustering));
+            }
+        }
+    }
+    return graph_test::report();
+}
@@ -0,0 +1,232 @@
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+#include "../graph/adjacency_list.hpp"
+#include "../graph/adjacency_matrix.hpp"
+#include "../graph/compressed_graph.hpp"
+
+// bytes requested from operator new so far, to bound what reserve hints cost
+static std::size_t allocated_bytes = 0;
+
+void *operator new(std::size_t size) {
+    allocated_bytes += size;
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+// a vertex info counting how often it is built from a name, copied or moved
+struct Name {
+    static inline std::size_t built = 0, copied = 0, moved = 0;
+
+    static void reset() { built = copied = moved = 0; }
+
+    explicit Name(std::string_view name) : name(name) { ++built; }
+    Name(const Name &other) : name(other.name) { ++copied; }
+    Name(Name &&other) noexcept : name(std::move(other.name)) { ++moved; }
+    Name &operator=(const Name &other) { name = other.name; ++copied; return *this; }
+    Name &operator=(Name &&other) noexcept { name = std::move(other.name); ++moved; return *this; }
+
+    friend bool operator==(const Name &a, const Name &b) { return a.name == b.name; }
+    friend bool operator==(const Name &a, std::string_view b) { return a.name == b; }
+
+    std::string name;
+};
+
+// adding a vertex always checks for duplicates, the unchecked append is not public
+template <typename G, typename = void>
+struct has_public_append : std::false_type { };
+
+template <typename G>
+struct has_public_append<G, std::void_t<decltype(std::declval<G &>().appendVertex(std::declval<Name>()))>>
+    : std::true_type { };
+
+static_assert(!has_public_append<graph::AdjacencyList<false, Name>>::value);
+static_assert(!has_public_append<graph::AdjacencyMatrix<false, Name>>::value);
+
+// the adjacency iterators yield proxies or values, so they only claim to be input iterators
+static_assert(std::is_same_v<std::iterator_traits<graph::AdjacencyList<false, Name>::iterator>::iterator_category,
+                             std::input_iterator_tag>);
+static_assert(std::is_same_v<std::iterator_traits<graph::AdjacencyMatrix<false, Name>::iterator>::iterator_category,
+                             std::input_iterator_tag>);
+static_assert(std::is_same_v<std::iterator_traits<graph::CompressedAdjacencyIterator>::iterator_category,
+                             std::input_iterator_tag>);
+
+template <typename G>
+std::vector<std::size_t> targets(const G &g, std::string_view v) {
+    std::vector<std::size_t> res;
+    for (auto beg = g.adjacencyVertexBegin(v), end = g.adjacencyVertexEnd(v); beg != end; ++beg)
+        res.push_back((*beg).to);
+    std::vector<std::size_t> listed;
+    for (auto record : g.neighbors(v))
+        listed.push_back(record.to);
+    CHECK(listed == res);
+    return res;
+}
+
+// lookups and insertions keyed by a name build a Name only for a new vertex
+template <typename G>
+void check_keys() {
+    Name::reset();
+    G g;
+    g.setEdge("a", "b", true);
+    CHECK(Name::built == 2 && g.vertexNumber() == 2);
+    g.setEdge("a", std::string_view("c"), true);
+    g.setEdge(std::string_view("b"), std::string_view("a"), true);
+    graph::add_edge(g, "c", "d");
+    CHECK(Name::built == 4 && g.vertexNumber() == 4);
+
+    CHECK(g.getEdge("a", "b") && g.getEdge(std::string_view("c"), "d") && !g.getEdge("b", "d"));
+    CHECK((targets(g, "a") == std::vector<std::size_t>{ 1, 2 }));
+    CHECK((targets(g, "d") == std::vector<std::size_t>{ 2 }) == !G::is_directed);
+    CHECK(g.neighbors(std::string_view("b")).begin() != g.neighbors(std::string_view("b")).end());
+    CHECK_THROWS(g.getEdge("a", "x"), std::out_of_range);
+    CHECK_THROWS(g.neighbors("x"), std::out_of_range);
+    CHECK_THROWS(g.adjacencyVertexBegin(std::string_view("x")), std::out_of_range);
+    CHECK(Name::built == 4 && Name::copied == 0);
+
+    // a vertex info, an index or a mix of info and key still take their overloads
+    Name a("a"), c("c");
+    CHECK(g.getEdge(a, c) && g.getEdge(std::size_t(0), std::size_t(2)) && g.getEdge(a, "c"));
+    g.setEdge(a, "e", true);
+    g.setEdge(std::size_t(4), std::size_t(3), true);
+    CHECK(g.vertexNumber() == 5 && g.getEdge("a", "e") && g.getEdge(std::string_view("e"), "d"));
+    CHECK(Name::built == 7 && Name::copied == 0);
+
+    // removing by key
+    graph::remove_edge(g, "a", "b");
+    CHECK(!g.getEdge("a", "b") && g.vertexNumber() == 5 && Name::built == 7);
+}
+
+template <typename G>
+void check_string_keys() {
+    G g;
+    std::string_view names[] = { "x", "y", "z" };
+    g.setEdge(names[0], names[1], 3);
+    g.setEdge(names[1], names[2], 4);
+    CHECK(g.getEdge(std::string("x"), std::string("y")) == 3 && g.getEdge(names[1], names[2]) == 4);
+    CHECK(g.getEdge("x", "z") == 0 && g.indexOfVertex(names[2]) == 2);
+}
+
+// emplaceVertex builds in place when there is room, and a duplicate never grows the graph
+template <typename G>
+void check_emplace() {
+    G g;
+    g.reserve(3);
+    Name::reset();
+    CHECK(g.emplaceVertex("a") == 0 && g.emplaceVertex(std::string_view("b")) == 1);
+    CHECK(g.emplaceVertex("a") == 0 && g.vertexNumber() == 2);
+    CHECK(Name::built == 3 && Name::moved == 0 && Name::copied == 0);
+    CHECK(g.emplaceVertex("c") == 2 && Name::moved == 0);
+
+    // full: the duplicate is looked up aside instead of reallocating the vertices
+    Name::reset();
+    CHECK(g.emplaceVertex("b") == 1 && g.vertexNumber() == 3);
+    CHECK(Name::built == 1 && Name::moved == 0 && Name::copied == 0);
+    CHECK(g.emplaceVertex("d") == 3 && g.vertexNumber() == 4 && g.getVertex(3) == "d");
+    CHECK(Name::built == 2 && Name::copied == 0);
+    g.setEdge(std::size_t(3), std::size_t(0), true);
+    CHECK(g.getEdge("d", "a") && !g.getEdge("d", "b"));
+}
+
+// reserved room is used without moving the vertices already there
+template <typename G>
+void check_reserve() {
+    G g;
+    g.reserve(100, 300);
+    Name::reset();
+    for (std::size_t v = 0; v < 100; ++v)
+        g.addVertex(Name(std::to_string(v)));
+    CHECK(Name::built == 100 && Name::moved == 100 && Name::copied == 0);
+    for (std::size_t v = 0; v < 300; ++v)
+        g.setEdge(v % 100, v * 7 % 100, true);
+    CHECK(g.vertexNumber() == 100 && g.getEdge("0", "0") && g.getEdge("1", "7"));
+    CHECK(Name::copied == 0 && Name::moved == 100);
+    g.reserve(0);
+    CHECK(g.vertexNumber() == 100 && g.getEdge("99", "93"));
+}
+
+// the edge hint covers the reserved vertices only, and reserve(0, 0) drops it
+template <bool IsDirected>
+void check_reserve_hint() {
+    using G = graph::AdjacencyList<IsDirected, std::size_t *>;
+    std::size_t ids[1104];
+    G g;
+    g.reserve(4, 400000);
+    auto before = allocated_bytes;
+    for (std::size_t v = 0; v < 1004; ++v)
+        g.addVertex(ids + v);
+    // 4 vertices with room for 100000 or 200000 edges, plus the vertex array
+    std::size_t hinted = 4 * (IsDirected ? 100000 : 200000) * (sizeof(std::size_t) + sizeof(bool));
+    CHECK(allocated_bytes - before < hinted + 1004 * 256);
+    CHECK(allocated_bytes - before >= hinted);
+
+    g.reserve(0, 0);
+    before = allocated_bytes;
+    for (std::size_t v = 1004; v < 1104; ++v)
+        g.addVertex(ids + v);
+    g.setEdge(std::size_t(1100), std::size_t(1101), true);
+    CHECK(allocated_bytes - before < 1104 * 256);
+    CHECK(g.vertexNumber() == 1104 && g.getEdge(ids + 1101, ids + 1100) == !IsDirected);
+}
+
+// moves and swaps take the vertices, edges and default edge info along without copying
+template <typename G>
+void check_move_and_swap() {
+    G g(-1), other(-2);
+    g.setEdge("a", "b", 5);
+    g.setEdge("b", "c", 6);
+    other.setEdge("x", "y", 7);
+    Name::reset();
+
+    G moved(std::move(g));
+    CHECK(moved.vertexNumber() == 3 && moved.getEdge("a", "b") == 5 && moved.getEdge("a", "c") == -1);
+    CHECK(moved.defaultEdgeInfo() == -1);
+    g = std::move(other);
+    CHECK(g.vertexNumber() == 2 && g.getEdge("x", "y") == 7 && g.defaultEdgeInfo() == -2);
+
+    swap(g, moved);
+    CHECK(g.vertexNumber() == 3 && g.getEdge("b", "c") == 6 && g.defaultEdgeInfo() == -1);
+    CHECK(moved.vertexNumber() == 2 && moved.getEdge("x", "y") == 7 && moved.defaultEdgeInfo() == -2);
+    g.swap(moved);
+    CHECK(g.vertexNumber() == 2 && moved.vertexNumber() == 3 && moved.getEdge("c", "b") == (G::is_directed ? -1 : 6));
+    CHECK(Name::copied == 0 && Name::built == 0);
+
+    // the defaults travel with the graph, setting one removes the edge
+    g.setEdge("x", "y", -2);
+    CHECK(g.neighbors("x").begin() == g.neighbors("x").end());
+    moved.setEdge("a", "b", -1);
+    CHECK(moved.neighbors("a").begin() == moved.neighbors("a").end());
+}
+
+int main() {
+    check_keys<graph::AdjacencyList<false, Name>>();
+    check_keys<graph::AdjacencyList<true, Name>>();
+    check_keys<graph::AdjacencyMatrix<false, Name>>();
+    check_keys<graph::AdjacencyMatrix<true, Name>>();
+    check_emplace<graph::AdjacencyList<false, Name>>();
+    check_emplace<graph::AdjacencyMatrix<true, Name>>();
+    check_reserve<graph::AdjacencyList<false, Name>>();
+    check_reserve<graph::AdjacencyMatrix<true, Name>>();
+    check_reserve_hint<false>();
+    check_reserve_hint<true>();
+    check_move_and_swap<graph::AdjacencyList<false, Name, int>>();
+    check_move_and_swap<graph::AdjacencyList<true, Name, int>>();
+    check_move_and_swap<graph::AdjacencyMatrix<false, Name, int>>();
+    check_move_and_swap<graph::AdjacencyMatrix<true, Name, int>>();
+    check_string_keys<graph::AdjacencyList<true, std::string, int>>();
+    check_string_keys<graph::AdjacencyMatrix<false, std::string, int>>();
+    return graph_test::report();
+}